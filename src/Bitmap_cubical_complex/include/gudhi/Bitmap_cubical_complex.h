@@ -26,6 +26,9 @@
 #include <gudhi/Bitmap_cubical_complex_base.h>
 #include <gudhi/Bitmap_cubical_complex_periodic_boundary_conditions_base.h>
 
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/range/iterator_range.hpp>
+
 #ifdef GUDHI_USE_TBB
 #include <tbb/parallel_sort.h>
 #endif
@@ -240,10 +243,44 @@ class Bitmap_cubical_complex : public T {
   //*********************************************//
 
   /**
-   * Boundary_simplex_range class provides ranges for boundary iterators.
+   * Boundary_simplex_range class provides ranges for boundary iterators. The boundary is computed on the fly, see
+   * Bitmap_cubical_complex_base::Incident_cells_iterator.
    **/
-  typedef typename std::vector<Simplex_handle>::iterator Boundary_simplex_iterator;
-  typedef typename std::vector<Simplex_handle> Boundary_simplex_range;
+  typedef typename T::Incident_cells_iterator Boundary_simplex_iterator;
+  typedef typename T::Incident_cells_range Boundary_simplex_range;
+
+  /**
+   * Boundary_oriented_simplex_iterator gives the cells of a boundary with their incidence coefficients, which are
+   * alternating, starting from +1.
+   **/
+  class Boundary_oriented_simplex_iterator
+      : public boost::iterator_facade<Boundary_oriented_simplex_iterator, std::pair<Simplex_handle, int> const,
+                                      boost::forward_traversal_tag, std::pair<Simplex_handle, int> > {
+   public:
+    Boundary_oriented_simplex_iterator() : incidence(1) {}
+
+    explicit Boundary_oriented_simplex_iterator(Boundary_simplex_iterator it) : it(it), incidence(1) {}
+
+   private:
+    friend class boost::iterator_core_access;
+
+    bool equal(Boundary_oriented_simplex_iterator const& other) const { return it == other.it; }
+
+    std::pair<Simplex_handle, int> dereference() const { return std::make_pair(*it, incidence); }
+
+    void increment() {
+      ++it;
+      incidence = -incidence;
+    }
+
+    Boundary_simplex_iterator it;
+    int incidence;
+  };
+
+  /**
+   * Boundary_oriented_simplex_range gives the cells of a boundary with their incidence coefficients.
+   **/
+  typedef boost::iterator_range<Boundary_oriented_simplex_iterator> Boundary_oriented_simplex_range;
 
   /**
    * Filtration_simplex_iterator class provides an iterator though the whole structure in the order of filtration.
@@ -351,7 +388,18 @@ class Bitmap_cubical_complex : public T {
    * boundary_simplex_range creates an object of a Boundary_simplex_range class
    * that provides ranges for the Boundary_simplex_iterator.
    **/
-  Boundary_simplex_range boundary_simplex_range(Simplex_handle sh) { return this->get_boundary_of_a_cell(sh); }
+  Boundary_simplex_range boundary_simplex_range(Simplex_handle sh) { return this->boundary_cells_range(sh); }
+
+  /**
+   * boundary_oriented_simplex_range returns the cells of the boundary of sh with their incidence coefficients, as
+   * required by the Gudhi persistent homology engines. The boundary elements are returned in the order of
+   * get_boundary_of_a_cell so that the incidence coefficients are alternating, starting from +1.
+   **/
+  Boundary_oriented_simplex_range boundary_oriented_simplex_range(Simplex_handle sh) {
+    Boundary_simplex_range bdry = this->boundary_cells_range(sh);
+    return Boundary_oriented_simplex_range(Boundary_oriented_simplex_iterator(bdry.begin()),
+                                           Boundary_oriented_simplex_iterator(bdry.end()));
+  }
 
   /**
    * filtration_simplex_range creates an object of a Filtration_simplex_range class
@@ -380,17 +428,18 @@ class Bitmap_cubical_complex : public T {
    * Function needed for compatibility with Gudhi. Not useful for other purposes.
    **/
   std::pair<Simplex_handle, Simplex_handle> endpoints(Simplex_handle sh) {
-    std::vector<std::size_t> bdry = this->get_boundary_of_a_cell(sh);
+    Boundary_simplex_range bdry = this->boundary_cells_range(sh);
     if (globalDbg) {
       std::cerr << "std::pair<Simplex_handle, Simplex_handle> endpoints( Simplex_handle sh )\n";
-      std::cerr << "bdry.size() : " << bdry.size() << "\n";
     }
     // this method returns two first elements from the boundary of sh.
-    if (bdry.size() < 2)
+    Boundary_simplex_iterator it = bdry.begin();
+    if (it == bdry.end())
       throw(
           "Error in endpoints in Bitmap_cubical_complex class. The cell have less than two elements in the "
           "boundary.");
-    return std::make_pair(bdry[0], bdry[1]);
+    Simplex_handle first = *it;
+    return std::make_pair(first, *++it);
   }
 
   /**
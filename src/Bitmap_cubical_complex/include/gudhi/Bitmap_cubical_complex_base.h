@@ -25,6 +25,8 @@
 
 #include <gudhi/Bitmap_cubical_complex/counter.h>
 
+#include <boost/iterator/iterator_facade.hpp>
+
 #include <iostream>
 #include <vector>
 #include <string>
@@ -35,6 +37,7 @@
 #include <utility>
 #include <stdexcept>
 #include <cstddef>
+#include <cstdint>
 
 namespace Gudhi {
 
@@ -67,7 +70,8 @@ class Bitmap_cubical_complex_base {
   /**
    *Default constructor
    **/
-  Bitmap_cubical_complex_base() : total_number_of_cells(0) {}
+  Bitmap_cubical_complex_base()
+      : total_number_of_cells(0), periodic_directions(0), boundary_starts_with_upper_face(false) {}
   /**
    * There are a few constructors of a Bitmap_cubical_complex_base class.
    * First one, that takes vector<unsigned>, creates an empty bitmap of a dimension equal
@@ -141,34 +145,45 @@ class Bitmap_cubical_complex_base {
   * dimensional face of a cube \f$A\f$.
   **/
   virtual int compute_incidence_between_cells(std::size_t coface, std::size_t face) const {
-    // first get the counters for coface and face:
-    std::vector<unsigned> coface_counter = this->compute_counter_for_given_cell(coface);
-    std::vector<unsigned> face_counter = this->compute_counter_for_given_cell(face);
-
-    // coface_counter and face_counter should agree at all positions except from one:
-    int number_of_position_in_which_counters_do_not_agree = -1;
-    std::size_t number_of_full_faces_that_comes_before = 0;
-    for (std::size_t i = 0; i != coface_counter.size(); ++i) {
-      if ((coface_counter[i] % 2 == 1) && (number_of_position_in_which_counters_do_not_agree == -1)) {
-        ++number_of_full_faces_that_comes_before;
-      }
-      if (coface_counter[i] != face_counter[i]) {
-        if (number_of_position_in_which_counters_do_not_agree != -1) {
-          std::cout << "Cells given to compute_incidence_between_cells procedure do not form a pair of coface-face.\n";
-          throw std::logic_error(
-              "Cells given to compute_incidence_between_cells procedure do not form a pair of coface-face.");
+    // Find the only direction in which the positions of the cells differ, and count the full faces of coface below
+    // it. The position of a cell in a direction ranges over 2 * size, or 2 * size + 1 cells if it is not periodic.
+    std::size_t direction = this->multipliers.size();
+    std::size_t coface_position = 0;
+    std::size_t face_position = 0;
+    std::size_t number_of_full_faces_that_comes_before = 1;
+    std::size_t coface1 = coface;
+    std::size_t face1 = face;
+    for (std::size_t i = this->multipliers.size(); i != 0; --i) {
+      std::size_t position1 = coface1 / this->multipliers[i - 1];
+      std::size_t position2 = face1 / this->multipliers[i - 1];
+      coface1 = coface1 % this->multipliers[i - 1];
+      face1 = face1 % this->multipliers[i - 1];
+      if (position1 != position2) {
+        if (direction != this->multipliers.size()) {
+          direction = this->multipliers.size() + 1;
+          break;
         }
-        number_of_position_in_which_counters_do_not_agree = i;
+        direction = i - 1;
+        coface_position = position1;
+        face_position = position2;
+      } else if (direction < this->multipliers.size() && position1 % 2 == 1) {
+        ++number_of_full_faces_that_comes_before;
       }
     }
+    // In a periodic direction, the upper face of the last cell is the first one.
+    bool wrapped = (direction < this->multipliers.size()) && ((this->periodic_directions >> direction) & 1) &&
+                   (coface_position == 2 * this->sizes[direction] - 1) && (face_position == 0);
+    if ((direction >= this->multipliers.size()) || (coface_position % 2 == 0) ||
+        ((face_position + 1 != coface_position) && (face_position != coface_position + 1) && !wrapped)) {
+      std::cout << "Cells given to compute_incidence_between_cells procedure do not form a pair of coface-face.\n";
+      throw std::logic_error(
+          "Cells given to compute_incidence_between_cells procedure do not form a pair of coface-face.");
+    }
 
     int incidence = 1;
     if (number_of_full_faces_that_comes_before % 2) incidence = -1;
     // if the face cell is on the right from coface cell:
-    if (coface_counter[number_of_position_in_which_counters_do_not_agree] + 1 ==
-        face_counter[number_of_position_in_which_counters_do_not_agree]) {
-      incidence *= -1;
-    }
+    if (face_position + 1 != coface_position) incidence *= -1;
 
     return incidence;
   }
@@ -351,6 +366,112 @@ class Bitmap_cubical_complex_base {
    **/
   Coboundary_range coboundary_range(std::size_t sh) { return this->get_coboundary_of_a_cell(sh); }
 
+  /**
+   * @brief Iterator over the boundary or the coboundary of a cell.
+   * @details The cells are computed on the fly from the multipliers of the bitmap, so that no memory is allocated.
+   * They are given in the same order as by get_boundary_of_a_cell and get_coboundary_of_a_cell, which is also valid for
+   * the periodic complexes. The (co)faces of a cell in the direction i are encoded by the bits 2*i+1 (for the first
+   * one) and 2*i (for the second one) of a mask, which is scanned from the last direction to the first one.
+   **/
+  class Incident_cells_iterator
+      : public boost::iterator_facade<Incident_cells_iterator, std::size_t const, boost::forward_traversal_tag,
+                                      std::size_t> {
+   public:
+    Incident_cells_iterator() : b(nullptr), cell(0), faces(0), upper_face_first(0), wrapped_faces(0), bit(-1) {}
+
+    Incident_cells_iterator(const Bitmap_cubical_complex_base* b, std::size_t cell, std::uint64_t faces,
+                            std::uint64_t upper_face_first, std::uint64_t wrapped_faces)
+        : b(b),
+          cell(cell),
+          faces(faces),
+          upper_face_first(upper_face_first),
+          wrapped_faces(wrapped_faces),
+          bit(2 * static_cast<int>(b->multipliers.size())) {
+      increment();
+    }
+
+   private:
+    friend class boost::iterator_core_access;
+
+    bool equal(Incident_cells_iterator const& other) const { return bit == other.bit; }
+
+    std::size_t dereference() const {
+      std::size_t direction = bit / 2;
+      bool upper = ((bit % 2) == 1) == (((upper_face_first >> direction) & 1) == 1);
+      std::size_t offset = b->multipliers[direction];
+      if ((wrapped_faces >> bit) & 1) {
+        // The face lies across a periodic boundary, one period away from cell +/- offset.
+        std::size_t period = 2 * b->sizes[direction] * offset;
+        return upper ? cell + offset - period : cell + period - offset;
+      }
+      return upper ? cell + offset : cell - offset;
+    }
+
+    void increment() {
+      do {
+        --bit;
+      } while (bit >= 0 && ((faces >> bit) & 1) == 0);
+    }
+
+    const Bitmap_cubical_complex_base* b;
+    std::size_t cell;
+    std::uint64_t faces;
+    // One bit per direction, set when the face on the upper side comes first.
+    std::uint64_t upper_face_first;
+    std::uint64_t wrapped_faces;
+    int bit;
+  };
+
+  /**
+   * @brief Range over the boundary or the coboundary of a cell, see Incident_cells_iterator.
+   **/
+  class Incident_cells_range {
+   public:
+    typedef Incident_cells_iterator const_iterator;
+    typedef Incident_cells_iterator iterator;
+
+    Incident_cells_range(const Bitmap_cubical_complex_base* b, std::size_t cell, std::uint64_t faces,
+                         std::uint64_t upper_face_first, std::uint64_t wrapped_faces)
+        : first(b, cell, faces, upper_face_first, wrapped_faces) {}
+
+    Incident_cells_iterator begin() const { return first; }
+
+    Incident_cells_iterator end() const { return Incident_cells_iterator(); }
+
+   private:
+    Incident_cells_iterator first;
+  };
+
+  /**
+   * boundary_cells_range returns the boundary of a cell, in the same order as get_boundary_of_a_cell, without
+   * allocating any memory. The incidence coefficients of the boundary elements are therefore alternating.
+   **/
+  Incident_cells_range boundary_cells_range(std::size_t cell) const {
+    switch (this->multipliers.size()) {
+      case 2:
+        return compute_boundary_cells_range<2>(cell);
+      case 3:
+        return compute_boundary_cells_range<3>(cell);
+      default:
+        return compute_boundary_cells_range<0>(cell);
+    }
+  }
+
+  /**
+   * coboundary_cells_range returns the coboundary of a cell, in the same order as get_coboundary_of_a_cell, without
+   * allocating any memory.
+   **/
+  Incident_cells_range coboundary_cells_range(std::size_t cell) const {
+    switch (this->multipliers.size()) {
+      case 2:
+        return compute_coboundary_cells_range<2>(cell);
+      case 3:
+        return compute_coboundary_cells_range<3>(cell);
+      default:
+        return compute_coboundary_cells_range<0>(cell);
+    }
+  }
+
   /**
    * @brief Iterator through top dimensional cells of the complex. The cells appear in order they are stored
    * in the structure (i.e. in lexicographical order)
@@ -484,8 +605,72 @@ class Bitmap_cubical_complex_base {
   std::vector<unsigned> multipliers;
   std::vector<T> data;
   std::size_t total_number_of_cells;
+  // One bit per direction in which the periodic boundary conditions are imposed.
+  std::uint64_t periodic_directions;
+  // The masks of Incident_cells_iterator use two bits per direction, hence the maximal dimension of a bitmap.
+  static const std::size_t max_dimension = 32;
+  // Whether the boundary of a cell starts with its upper face in its last direction of nonzero length. This is the
+  // order used by the periodic complexes, while the lower face comes first in this class.
+  bool boundary_starts_with_upper_face;
+
+  // The boundary and coboundary masks of Incident_cells_iterator. When Dimension is not 0, it is the dimension of the
+  // bitmap and the loop over the directions is unrolled by the compiler.
+  template <std::size_t Dimension>
+  Incident_cells_range compute_boundary_cells_range(std::size_t cell) const {
+    std::uint64_t faces = 0;
+    std::uint64_t upper_face_first = 0;
+    std::uint64_t wrapped_faces = 0;
+    bool upper_first = this->boundary_starts_with_upper_face;
+    std::size_t cell1 = cell;
+    for (std::size_t i = (Dimension ? Dimension : this->multipliers.size()); i != 0; --i) {
+      std::size_t position = cell1 / this->multipliers[i - 1];
+      cell1 = cell1 % this->multipliers[i - 1];
+      if (position % 2 == 0) continue;
+      faces |= std::uint64_t(3) << (2 * (i - 1));
+      if (upper_first) upper_face_first |= std::uint64_t(1) << (i - 1);
+      if (((this->periodic_directions >> (i - 1)) & 1) && (position == 2 * this->sizes[i - 1] - 1)) {
+        wrapped_faces |= std::uint64_t(1) << (2 * (i - 1) + (upper_first ? 1 : 0));
+      }
+      upper_first = !upper_first;
+    }
+    return Incident_cells_range(this, cell, faces, upper_face_first, wrapped_faces);
+  }
+
+  template <std::size_t Dimension>
+  Incident_cells_range compute_coboundary_cells_range(std::size_t cell) const {
+    std::uint64_t faces = 0;
+    std::uint64_t upper_face_first = 0;
+    std::uint64_t wrapped_faces = 0;
+    std::size_t cell1 = cell;
+    for (std::size_t i = (Dimension ? Dimension : this->multipliers.size()); i != 0; --i) {
+      std::size_t position = cell1 / this->multipliers[i - 1];
+      cell1 = cell1 % this->multipliers[i - 1];
+      if (position % 2 == 1) continue;
+      if (position != 0) {
+        faces |= std::uint64_t(2) << (2 * (i - 1));
+      } else if ((this->periodic_directions >> (i - 1)) & 1) {
+        // The lower coface is across the periodic boundary, and comes after the upper one.
+        faces |= std::uint64_t(1) << (2 * (i - 1));
+        upper_face_first |= std::uint64_t(1) << (i - 1);
+        wrapped_faces |= std::uint64_t(1) << (2 * (i - 1));
+      }
+      if (position != 2 * this->sizes[i - 1]) {
+        faces |= std::uint64_t(1) << (2 * (i - 1) + ((upper_face_first >> (i - 1)) & 1));
+      }
+    }
+    return Incident_cells_range(this, cell, faces, upper_face_first, wrapped_faces);
+  }
+
+  void check_dimension(const std::vector<unsigned>& sizes) const {
+    if (sizes.size() > max_dimension) {
+      throw std::invalid_argument("Bitmap_cubical_complex_base: the dimension of a bitmap cannot exceed 32.");
+    }
+  }
 
   void set_up_containers(const std::vector<unsigned>& sizes) {
+    this->check_dimension(sizes);
+    this->periodic_directions = 0;
+    this->boundary_starts_with_upper_face = false;
     unsigned multiplier = 1;
     for (std::size_t i = 0; i != sizes.size(); ++i) {
       this->sizes.push_back(sizes[i]);
@@ -703,49 +888,14 @@ Bitmap_cubical_complex_base<T>::Bitmap_cubical_complex_base(const char* perseus_
 
 template <typename T>
 std::vector<std::size_t> Bitmap_cubical_complex_base<T>::get_boundary_of_a_cell(std::size_t cell) const {
-  std::vector<std::size_t> boundary_elements;
-
-  // Speed traded of for memory. Check if it is better in practice.
-  boundary_elements.reserve(this->dimension() * 2);
-
-  std::size_t sum_of_dimensions = 0;
-  std::size_t cell1 = cell;
-  for (std::size_t i = this->multipliers.size(); i != 0; --i) {
-    unsigned position = cell1 / this->multipliers[i - 1];
-    if (position % 2 == 1) {
-      if (sum_of_dimensions % 2) {
-        boundary_elements.push_back(cell + this->multipliers[i - 1]);
-        boundary_elements.push_back(cell - this->multipliers[i - 1]);
-      } else {
-        boundary_elements.push_back(cell - this->multipliers[i - 1]);
-        boundary_elements.push_back(cell + this->multipliers[i - 1]);
-      }
-      ++sum_of_dimensions;
-    }
-    cell1 = cell1 % this->multipliers[i - 1];
-  }
-
-  return boundary_elements;
+  Incident_cells_range boundary = this->boundary_cells_range(cell);
+  return std::vector<std::size_t>(boundary.begin(), boundary.end());
 }
 
 template <typename T>
 std::vector<std::size_t> Bitmap_cubical_complex_base<T>::get_coboundary_of_a_cell(std::size_t cell) const {
-  std::vector<unsigned> counter = this->compute_counter_for_given_cell(cell);
-  std::vector<std::size_t> coboundary_elements;
-  std::size_t cell1 = cell;
-  for (std::size_t i = this->multipliers.size(); i != 0; --i) {
-    unsigned position = cell1 / this->multipliers[i - 1];
-    if (position % 2 == 0) {
-      if ((cell > this->multipliers[i - 1]) && (counter[i - 1] != 0)) {
-        coboundary_elements.push_back(cell - this->multipliers[i - 1]);
-      }
-      if ((cell + this->multipliers[i - 1] < this->data.size()) && (counter[i - 1] != 2 * this->sizes[i - 1])) {
-        coboundary_elements.push_back(cell + this->multipliers[i - 1]);
-      }
-    }
-    cell1 = cell1 % this->multipliers[i - 1];
-  }
-  return coboundary_elements;
+  Incident_cells_range coboundary = this->coboundary_cells_range(cell);
+  return std::vector<std::size_t>(coboundary.begin(), coboundary.end());
 }
 
 template <typename T>
@@ -807,23 +957,22 @@ void Bitmap_cubical_complex_base<T>::impose_lower_star_filtration() {
     }
     std::vector<std::size_t> new_indices_to_consider;
     for (std::size_t i = 0; i != indices_to_consider.size(); ++i) {
-      std::vector<std::size_t> bd = this->get_boundary_of_a_cell(indices_to_consider[i]);
-      for (std::size_t boundaryIt = 0; boundaryIt != bd.size(); ++boundaryIt) {
+      for (std::size_t bd : this->boundary_cells_range(indices_to_consider[i])) {
         if (dbg) {
-          std::cerr << "filtration of a cell : " << bd[boundaryIt] << " is : " << this->data[bd[boundaryIt]]
+          std::cerr << "filtration of a cell : " << bd << " is : " << this->data[bd]
                     << " while of a cell: " << indices_to_consider[i] << " is: " << this->data[indices_to_consider[i]]
                     << std::endl;
         }
-        if (this->data[bd[boundaryIt]] > this->data[indices_to_consider[i]]) {
-          this->data[bd[boundaryIt]] = this->data[indices_to_consider[i]];
+        if (this->data[bd] > this->data[indices_to_consider[i]]) {
+          this->data[bd] = this->data[indices_to_consider[i]];
           if (dbg) {
-            std::cerr << "Setting the value of a cell : " << bd[boundaryIt]
-                      << " to : " << this->data[indices_to_consider[i]] << std::endl;
+            std::cerr << "Setting the value of a cell : " << bd << " to : " << this->data[indices_to_consider[i]]
+                      << std::endl;
           }
         }
-        if (is_this_cell_considered[bd[boundaryIt]] == false) {
-          new_indices_to_consider.push_back(bd[boundaryIt]);
-          is_this_cell_considered[bd[boundaryIt]] = true;
+        if (is_this_cell_considered[bd] == false) {
+          new_indices_to_consider.push_back(bd);
+          is_this_cell_considered[bd] = true;
         }
       }
     }
@@ -30,6 +30,7 @@
 #include <vector>
 #include <stdexcept>
 #include <cstddef>
+#include <cstdint>
 
 namespace Gudhi {
 
@@ -165,12 +166,16 @@ class Bitmap_cubical_complex_periodic_boundary_conditions_base : public Bitmap_c
   std::vector<bool> directions_in_which_periodic_b_cond_are_to_be_imposed;
 
   void set_up_containers(const std::vector<unsigned>& sizes) {
+    this->check_dimension(sizes);
+    this->periodic_directions = 0;
+    this->boundary_starts_with_upper_face = true;
     unsigned multiplier = 1;
     for (std::size_t i = 0; i != sizes.size(); ++i) {
       this->sizes.push_back(sizes[i]);
       this->multipliers.push_back(multiplier);
 
       if (directions_in_which_periodic_b_cond_are_to_be_imposed[i]) {
+        this->periodic_directions |= std::uint64_t(1) << i;
         multiplier *= 2 * sizes[i];
       } else {
         multiplier *= 2 * sizes[i] + 1;
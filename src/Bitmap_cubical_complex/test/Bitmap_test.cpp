@@ -32,6 +32,7 @@
 #include <iostream>
 #include <sstream>
 #include <vector>
+#include <algorithm>
 
 typedef Gudhi::cubical_complex::Bitmap_cubical_complex_base<double> Bitmap_cubical_complex_base;
 typedef Gudhi::cubical_complex::Bitmap_cubical_complex<Bitmap_cubical_complex_base> Bitmap_cubical_complex;
@@ -1576,3 +1577,73 @@ BOOST_AUTO_TEST_CASE(compute_incidence_between_cells_test_periodic_boundary_cond
     }
   }
 }
+
+template <class Complex>
+void check_incident_cells_ranges(Complex& ba, std::size_t number_of_all_elements) {
+  std::vector<int> elems_in_boundary(number_of_all_elements, 0);
+  for (auto it = ba.all_cells_iterator_begin(); it != ba.all_cells_iterator_end(); ++it) {
+    auto bdrange = ba.boundary_cells_range(*it);
+    std::vector<std::size_t> bd(bdrange.begin(), bdrange.end());
+    BOOST_CHECK(bd == ba.get_boundary_of_a_cell(*it));
+    auto cbdrange = ba.coboundary_cells_range(*it);
+    std::vector<std::size_t> cbd(cbdrange.begin(), cbdrange.end());
+    BOOST_CHECK(cbd == ba.get_coboundary_of_a_cell(*it));
+
+    // the incidences computed through a const reference, i.e. by Bitmap_cubical_complex_base, agree with the ones of
+    // the complex, which the periodic complexes compute from the counters of the cells
+    const Bitmap_cubical_complex_base& const_ba = ba;
+    for (auto face : bd) {
+      BOOST_CHECK(const_ba.compute_incidence_between_cells(*it, face) == ba.compute_incidence_between_cells(*it, face));
+    }
+    if (!bd.empty()) {
+      BOOST_CHECK_THROW(const_ba.compute_incidence_between_cells(*it, *it), std::logic_error);
+    }
+
+    // the oriented boundary of the oriented boundary vanishes
+    for (auto osh : ba.boundary_oriented_simplex_range(*it)) {
+      for (auto osh2 : ba.boundary_oriented_simplex_range(osh.first)) {
+        elems_in_boundary[osh2.first] += osh.second * osh2.second;
+      }
+    }
+    BOOST_CHECK(std::count(elems_in_boundary.begin(), elems_in_boundary.end(), 0) ==
+                static_cast<std::ptrdiff_t>(elems_in_boundary.size()));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(incident_cells_ranges_test) {
+  for (std::size_t dimension = 1; dimension != 5; ++dimension) {
+    std::vector<unsigned> sizes(dimension, 3);
+    sizes[0] = 2;
+    std::size_t number_of_top_dimensional_cells = 1;
+    std::size_t number_of_all_elements = 1;
+    std::size_t number_of_all_periodic_elements = 1;
+    std::vector<bool> directions_of_periodicity(dimension);
+    for (std::size_t i = 0; i != dimension; ++i) {
+      number_of_top_dimensional_cells *= sizes[i];
+      number_of_all_elements *= 2 * sizes[i] + 1;
+      directions_of_periodicity[i] = (i % 2 == 0);
+      number_of_all_periodic_elements *= directions_of_periodicity[i] ? 2 * sizes[i] : 2 * sizes[i] + 1;
+    }
+    std::vector<double> data(number_of_top_dimensional_cells, 0);
+
+    Bitmap_cubical_complex ba(sizes, data);
+    check_incident_cells_ranges(ba, number_of_all_elements);
+    Bitmap_cubical_complex_periodic_boundary_conditions pba(sizes, data, directions_of_periodicity);
+    check_incident_cells_ranges(pba, number_of_all_periodic_elements);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(bitmap_dimension_test) {
+  // Bitmaps without any top dimensional cell, whose dimension is the only limit.
+  std::vector<unsigned> sizes(32, 0);
+  Bitmap_cubical_complex_base ba(sizes);
+  BOOST_CHECK(ba.dimension() == 32);
+
+  sizes.push_back(0);
+  std::vector<double> data;
+  std::vector<bool> directions_of_periodicity(33, true);
+  BOOST_CHECK_THROW(Bitmap_cubical_complex_base{sizes}, std::invalid_argument);
+  BOOST_CHECK_THROW(Bitmap_cubical_complex(sizes, data), std::invalid_argument);
+  BOOST_CHECK_THROW(Bitmap_cubical_complex_periodic_boundary_conditions(sizes, data, directions_of_periodicity),
+                    std::invalid_argument);
+}
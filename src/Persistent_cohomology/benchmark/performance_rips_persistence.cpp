@@ -24,6 +24,7 @@
 #include <gudhi/distance_functions.h>
 #include <gudhi/Simplex_tree.h>
 #include <gudhi/Persistent_cohomology.h>
+#include <gudhi/Persistent_homology_matrix_reduction.h>
 #include <gudhi/Persistent_cohomology/Multi_field.h>
 #include <gudhi/Hasse_complex.h>
 #include <gudhi/Points_off_io.h>
@@ -38,11 +39,14 @@ using Filtration_value = Simplex_tree::Filtration_value;
 using Rips_complex = Gudhi::rips_complex::Rips_complex<Filtration_value>;
 using Field_Zp = Gudhi::persistent_cohomology::Field_Zp;
 using Multi_field = Gudhi::persistent_cohomology::Multi_field;
+using Gudhi::persistent_cohomology::Persistent_cohomology;
+using Gudhi::persistent_cohomology::Persistent_homology_matrix_reduction;
 using Point = std::vector<double>;
 using Points_off_reader = Gudhi::Points_off_reader<Point>;
 
-/* Compute the persistent homology of the complex cpx with coefficients in Z/pZ. */
-template< typename FilteredComplex>
+/* Compute the persistent homology of the complex cpx with coefficients in Z/pZ, with the algorithm
+ * Persistence (Persistent_cohomology or Persistent_homology_matrix_reduction). */
+template< template<class, class> class Persistence, typename FilteredComplex>
 void timing_persistence(FilteredComplex & cpx
                         , int p);
 
@@ -63,7 +67,9 @@ void timing_persistence(FilteredComplex & cpx
  * a faster computation of persistence because boundaries are precomputed. 
  * Hovewer, the simplex tree may be constructed directly from a point cloud and
  * is more compact.
- * We compute persistent homology with coefficient fields Z/2Z and Z/1223Z.
+ * We compute persistent homology with coefficient fields Z/2Z and Z/1223Z,
+ * with the compressed annotation matrix and with the reduction of the boundary
+ * matrix.
  * We present also timings for the computation of multi-field persistent 
  * homology in all fields Z/rZ for r prime between 2 and 1223.
  */
@@ -129,15 +135,23 @@ int main(int argc, char * argv[]) {
 
 
   std::cout << "Timings when using a simplex tree: \n";
-  timing_persistence(st, p);
-  timing_persistence(st, q);
+  timing_persistence<Persistent_cohomology>(st, p);
+  timing_persistence<Persistent_cohomology>(st, q);
   timing_persistence(st, p, q);
 
+  std::cout << "Timings when using a simplex tree and boundary matrix reduction: \n";
+  timing_persistence<Persistent_homology_matrix_reduction>(st, p);
+  timing_persistence<Persistent_homology_matrix_reduction>(st, q);
+
   std::cout << "Timings when using a Hasse complex: \n";
-  timing_persistence(hcpx, p);
-  timing_persistence(hcpx, q);
+  timing_persistence<Persistent_cohomology>(hcpx, p);
+  timing_persistence<Persistent_cohomology>(hcpx, q);
   timing_persistence(hcpx, p, q);
 
+  std::cout << "Timings when using a Hasse complex and boundary matrix reduction: \n";
+  timing_persistence<Persistent_homology_matrix_reduction>(hcpx, p);
+  timing_persistence<Persistent_homology_matrix_reduction>(hcpx, q);
+
   start = std::chrono::system_clock::now();
   }
   end = std::chrono::system_clock::now();
@@ -146,7 +160,7 @@ int main(int argc, char * argv[]) {
   return 0;
 }
 
-template< typename FilteredComplex>
+template< template<class, class> class Persistence, typename FilteredComplex>
 void
 timing_persistence(FilteredComplex & cpx
                    , int p) {
@@ -154,7 +168,7 @@ timing_persistence(FilteredComplex & cpx
   int elapsed_sec;
   {
   start = std::chrono::system_clock::now();
-  Gudhi::persistent_cohomology::Persistent_cohomology< FilteredComplex, Field_Zp > pcoh(cpx);
+  Persistence< FilteredComplex, Field_Zp > pcoh(cpx);
   end = std::chrono::system_clock::now();
   elapsed_sec = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
   std::cout << "  Initialize pcoh in " << elapsed_sec << " ms.\n";
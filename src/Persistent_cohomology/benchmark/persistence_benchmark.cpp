@@ -0,0 +1,315 @@
+/*    This file is part of the Gudhi Library. The Gudhi library
+ *    (Geometric Understanding in Higher Dimensions) is a generic C++
+ *    library for computational topology.
+ *
+ *    Author(s):       Gudhi contributors
+ *
+ *    Copyright (C) 2018 Inria
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gudhi/Rips_complex.h>
+#include <gudhi/Sparse_rips_complex.h>
+#include <gudhi/Bitmap_cubical_complex.h>
+#include <gudhi/distance_functions.h>
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Persistent_cohomology.h>
+
+// The Alpha and witness complexes, and their random point generators, require CGAL with Eigen3
+#ifdef PERSISTENCE_BENCHMARK_WITH_CGAL
+#include <gudhi/random_point_generators.h>
+#include <gudhi/Alpha_complex.h>
+#include <gudhi/Euclidean_witness_complex.h>
+#include <gudhi/pick_n_random_points.h>
+
+#include <CGAL/Epick_d.h>
+#endif
+
+#include <algorithm>  // for std::min
+#include <chrono>
+#include <cmath>  // for std::cbrt, std::cos, std::sin
+#include <random>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>  // for std::back_inserter
+#include <limits>
+#include <memory>  // for std::unique_ptr
+#include <string>
+#include <utility>  // for std::pair
+#include <vector>
+#include <cstdlib>  // for std::atoi, EXIT_SUCCESS, EXIT_FAILURE
+
+using Point = std::vector<double>;
+using Simplex_tree = Gudhi::Simplex_tree<Gudhi::Simplex_tree_options_fast_persistence>;
+using Filtration_value = Simplex_tree::Filtration_value;
+using Field_Zp = Gudhi::persistent_cohomology::Field_Zp;
+using Gudhi::persistent_cohomology::Persistent_cohomology;
+using Bitmap_cubical_complex = Gudhi::cubical_complex::Bitmap_cubical_complex<
+    Gudhi::cubical_complex::Bitmap_cubical_complex_base<double>>;
+
+/* Phases of a benchmark, as the columns of the report. */
+enum Phase { graph, expansion, filtration_sort, persistence, num_phases };
+
+/* Timings of the phases in ms, negative for the phases that a benchmark does not have, and size of the complex. */
+struct Benchmark_result {
+  Benchmark_result()
+      : times(num_phases, -1.),
+        num_simplices(0),
+        num_intervals(0),
+        peak_rss(0) {
+  }
+
+  /* Runs f, and adds its duration to the time of phase. */
+  template<typename Function>
+  void time(Phase phase, Function&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    times[phase] = (times[phase] < 0. ? 0. : times[phase]) +
+        std::chrono::duration<double, std::milli>(end - start).count();
+  }
+
+  std::vector<double> times;
+  std::size_t num_simplices;
+  std::size_t num_intervals;
+  // In kB
+  std::size_t peak_rss;
+};
+
+/* The peak resident set size is reset before each benchmark, which is only possible on Linux. It is reported as 0
+ * elsewhere. */
+void reset_peak_rss() {
+#ifdef __linux__
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  clear_refs << "5";
+#endif
+}
+
+/* Peak resident set size of the process since the last call to reset_peak_rss(), in kB. */
+std::size_t peak_rss() {
+  std::size_t rss = 0;
+#ifdef __linux__
+  std::ifstream status("/proc/self/status");
+  std::string field;
+  while (status >> field) {
+    if (field == "VmHWM:") {
+      status >> rss;
+      break;
+    }
+  }
+#endif
+  return rss;
+}
+
+/* Random points on the flat torus (S^1)^2 in R^4, with a uniform noise on each coordinate. */
+std::vector<Point> points_on_flat_torus(std::size_t num_points, double noise, std::mt19937& gen) {
+  std::uniform_real_distribution<double> angle(0., 6.283185307179586);
+  std::uniform_real_distribution<double> perturbation(-noise, noise);
+  std::vector<Point> points;
+  points.reserve(num_points);
+  for (std::size_t i = 0; i < num_points; ++i) {
+    double a = angle(gen), b = angle(gen);
+    points.push_back({std::cos(a) + perturbation(gen), std::sin(a) + perturbation(gen),
+                      std::cos(b) + perturbation(gen), std::sin(b) + perturbation(gen)});
+  }
+  return points;
+}
+
+/* Random points on the torus of revolution in R^3 of radii R and r. */
+std::vector<Point> points_on_torus_3d(std::size_t num_points, double R, double r, std::mt19937& gen) {
+  std::uniform_real_distribution<double> angle(0., 6.283185307179586);
+  std::vector<Point> points;
+  points.reserve(num_points);
+  for (std::size_t i = 0; i < num_points; ++i) {
+    double a = angle(gen), b = angle(gen);
+    points.push_back({(R + r * std::cos(b)) * std::cos(a), (R + r * std::cos(b)) * std::sin(a), r * std::sin(b)});
+  }
+  return points;
+}
+
+/* Sorts the filtration of st, and computes its persistent homology with coefficients in Z/2Z. */
+void simplex_tree_persistence(Simplex_tree& st, Benchmark_result& result) {
+  result.num_simplices = st.num_simplices();
+  result.time(filtration_sort, [&] { st.initialize_filtration(); });
+  result.time(persistence, [&] {
+    Persistent_cohomology<Simplex_tree, Field_Zp> pcoh(st);
+    pcoh.init_coefficients(2);
+    pcoh.compute_persistent_cohomology();
+    result.num_intervals = pcoh.get_persistent_pairs().size();
+  });
+}
+
+/* Rips complex of points on a flat torus in R^4, with many edges. */
+Benchmark_result rips_dense(std::size_t num_points) {
+  Benchmark_result result;
+  std::mt19937 gen(num_points);
+  std::vector<Point> points = points_on_flat_torus(num_points, 0.05, gen);
+  using Rips_complex = Gudhi::rips_complex::Rips_complex<Filtration_value>;
+  std::unique_ptr<Rips_complex> rips;
+  result.time(graph, [&] { rips.reset(new Rips_complex(points, 0.5, Gudhi::Euclidean_distance())); });
+  Simplex_tree st;
+  result.time(expansion, [&] { rips->create_complex(st, 3); });
+  simplex_tree_persistence(st, result);
+  return result;
+}
+
+/* Sparse Rips complex of the same points, without threshold. */
+Benchmark_result rips_sparse(std::size_t num_points) {
+  Benchmark_result result;
+  std::mt19937 gen(num_points);
+  std::vector<Point> points = points_on_flat_torus(num_points, 0.05, gen);
+  using Sparse_rips_complex = Gudhi::rips_complex::Sparse_rips_complex<Filtration_value>;
+  std::unique_ptr<Sparse_rips_complex> rips;
+  result.time(graph, [&] { rips.reset(new Sparse_rips_complex(points, Gudhi::Euclidean_distance(), 0.5)); });
+  Simplex_tree st;
+  result.time(expansion, [&] { rips->create_complex(st, 3); });
+  simplex_tree_persistence(st, result);
+  return result;
+}
+
+#ifdef PERSISTENCE_BENCHMARK_WITH_CGAL
+using Kernel = CGAL::Epick_d<CGAL::Dynamic_dimension_tag>;
+using Point_d = Kernel::Point_d;
+
+/* Alpha complex of points on a sphere in R^3. The graph phase is the Delaunay triangulation. */
+Benchmark_result alpha(std::size_t num_points) {
+  Benchmark_result result;
+  std::vector<Point_d> points = Gudhi::generate_points_on_sphere_d<Kernel>(num_points, 3, 1., 0.05);
+  using Alpha_complex = Gudhi::alpha_complex::Alpha_complex<Kernel>;
+  std::unique_ptr<Alpha_complex> alpha_complex;
+  result.time(graph, [&] { alpha_complex.reset(new Alpha_complex(points)); });
+  Simplex_tree st;
+  result.time(expansion, [&] { alpha_complex->create_complex(st); });
+  simplex_tree_persistence(st, result);
+  return result;
+}
+
+/* Euclidean witness complex of a tenth of points in a 4-dimensional cube, witnessed by all the points. The graph
+ * phase is the computation of the nearest landmarks of the witnesses. */
+Benchmark_result witness(std::size_t num_points) {
+  Benchmark_result result;
+  std::vector<Point_d> witnesses = Gudhi::generate_points_in_cube_d<Kernel>(num_points, 4, 1.);
+  std::vector<Point_d> landmarks;
+  Gudhi::subsampling::pick_n_random_points(witnesses, num_points / 10, std::back_inserter(landmarks));
+  using Witness_complex = Gudhi::witness_complex::Euclidean_witness_complex<Kernel>;
+  std::unique_ptr<Witness_complex> witness_complex;
+  result.time(graph, [&] { witness_complex.reset(new Witness_complex(landmarks, witnesses)); });
+  Simplex_tree st;
+  result.time(expansion, [&] { witness_complex->create_complex(st, 0.01, 3); });
+  simplex_tree_persistence(st, result);
+  return result;
+}
+#endif  // PERSISTENCE_BENCHMARK_WITH_CGAL
+
+/* Cubical complex of a 3D image of side num_cells^(1/3), whose values are the distances to points on a torus. The
+ * expansion phase is the construction of the bitmap, which also sorts its cells. */
+Benchmark_result bitmap_cubical(std::size_t num_cells) {
+  Benchmark_result result;
+  unsigned side = static_cast<unsigned>(std::cbrt(static_cast<double>(num_cells)));
+  std::mt19937 gen(num_cells);
+  std::vector<Point> points = points_on_torus_3d(5 * side, 1., 0.4, gen);
+  std::vector<double> top_dimensional_cells;
+  top_dimensional_cells.reserve(side * side * side);
+  // The first direction varies the fastest
+  for (unsigned z = 0; z < side; ++z)
+    for (unsigned y = 0; y < side; ++y)
+      for (unsigned x = 0; x < side; ++x) {
+        Point center = {2.8 * (x + .5) / side - 1.4, 2.8 * (y + .5) / side - 1.4, 0.8 * (z + .5) / side - 0.4};
+        double distance = std::numeric_limits<double>::infinity();
+        for (const Point& p : points)
+          distance = std::min(distance, Gudhi::Euclidean_distance()(center, p));
+        top_dimensional_cells.push_back(distance);
+      }
+  std::unique_ptr<Bitmap_cubical_complex> cubical;
+  result.time(expansion, [&] {
+    cubical.reset(new Bitmap_cubical_complex(std::vector<unsigned>(3, side), top_dimensional_cells));
+  });
+  result.num_simplices = cubical->num_simplices();
+  result.time(persistence, [&] {
+    Persistent_cohomology<Bitmap_cubical_complex, Field_Zp> pcoh(*cubical, true);
+    pcoh.init_coefficients(2);
+    pcoh.compute_persistent_cohomology();
+    result.num_intervals = pcoh.get_persistent_pairs().size();
+  });
+  return result;
+}
+
+/* Benchmarks of the construction of complexes and of their persistent homology, on random inputs. The rips_dense
+ * and rips_sparse benchmarks sample points_on_flat_torus, and the bitmap_cubical benchmark points_on_torus_3d, with a
+ * std::mt19937 seeded by the size of the input, so that their inputs are the same from one run to another. The alpha
+ * and witness benchmarks use generate_points_on_sphere_d and generate_points_in_cube_d of random_point_generators.h,
+ * whose CGAL::Random gives different points at each run. For each benchmark, the time of each phase is reported (the
+ * best one over the repetitions), along with the peak resident set size.
+ *
+ * Usage: Persistence_benchmark [filter [repetitions [scale]]]
+ * Only the benchmarks whose name contains filter are run. The default sizes of the inputs are multiplied by scale.
+ * The alpha and witness benchmarks are only available with CGAL. Returns EXIT_FAILURE if a benchmark gives an empty
+ * complex, so that a run on small inputs can serve as a test.
+ */
+int main(int argc, char * argv[]) {
+  std::string filter = argc > 1 ? argv[1] : "";
+  int repetitions = argc > 2 ? std::atoi(argv[2]) : 1;
+  double scale = argc > 3 ? std::atof(argv[3]) : 1.;
+
+  const std::vector<std::pair<std::string, std::function<Benchmark_result()>>> benchmarks = {
+    {"rips_dense", [&] { return rips_dense(static_cast<std::size_t>(2000 * scale)); }},
+    {"rips_sparse", [&] { return rips_sparse(static_cast<std::size_t>(500 * scale)); }},
+#ifdef PERSISTENCE_BENCHMARK_WITH_CGAL
+    {"alpha", [&] { return alpha(static_cast<std::size_t>(100000 * scale)); }},
+    {"witness", [&] { return witness(static_cast<std::size_t>(20000 * scale)); }},
+#endif
+    {"bitmap_cubical", [&] { return bitmap_cubical(static_cast<std::size_t>(1000000 * scale)); }},
+  };
+  const char* phase_names[num_phases] = {"graph", "expansion", "sort", "persistence"};
+
+  std::cout << std::left << std::setw(16) << "benchmark" << std::right << std::setw(12) << "simplices"
+      << std::setw(12) << "intervals";
+  for (const char* name : phase_names)
+    std::cout << std::setw(17) << std::string(name) + "(ms)";
+  std::cout << std::setw(14) << "peak RSS(MB)" << std::endl;
+
+  int status = EXIT_SUCCESS;
+  for (const auto& benchmark : benchmarks) {
+    if (benchmark.first.find(filter) == std::string::npos)
+      continue;
+    Benchmark_result best;
+    for (int i = 0; i < repetitions; ++i) {
+      reset_peak_rss();
+      Benchmark_result result = benchmark.second();
+      result.peak_rss = peak_rss();
+      if (i == 0) {
+        best = result;
+        continue;
+      }
+      for (int phase = 0; phase < num_phases; ++phase)
+        best.times[phase] = std::min(best.times[phase], result.times[phase]);
+      best.peak_rss = std::min(best.peak_rss, result.peak_rss);
+    }
+    std::cout << std::left << std::setw(16) << benchmark.first << std::right << std::setw(12) << best.num_simplices
+        << std::setw(12) << best.num_intervals << std::fixed << std::setprecision(1);
+    for (double time : best.times) {
+      if (time < 0.)
+        std::cout << std::setw(17) << "-";
+      else
+        std::cout << std::setw(17) << time;
+    }
+    std::cout << std::setw(14) << best.peak_rss / 1024. << std::endl;
+    if (best.num_simplices == 0 || best.num_intervals == 0)
+      status = EXIT_FAILURE;
+  }
+  return status;
+}
@@ -23,25 +23,23 @@
 #ifndef PERSISTENT_COHOMOLOGY_H_
 #define PERSISTENT_COHOMOLOGY_H_
 
-#include <gudhi/Persistent_cohomology/Persistent_cohomology_column.h>
 #include <gudhi/Persistent_cohomology/Field_Zp.h>
-#include <gudhi/Simple_object_pool.h>
+#include <gudhi/Persistent_cohomology/Field_Z2.h>
+#include <gudhi/Persistent_cohomology/Persistent_intervals.h>
+#include <gudhi/Persistent_cohomology/Linked_annotation_matrix.h>
+#include <gudhi/Persistent_cohomology/Contiguous_annotation_matrix.h>
 
-#include <boost/intrusive/set.hpp>
 #include <boost/pending/disjoint_sets.hpp>
-#include <boost/intrusive/list.hpp>
 
-#include <map>
 #include <utility>
 #include <list>
 #include <vector>
 #include <set>
-#include <fstream>  // std::ofstream
 #include <limits>  // for numeric_limits<>
 #include <tuple>
 #include <algorithm>
 #include <string>
-#include <stdexcept>  // for std::out_of_range
+#include <stdexcept>  // for std::out_of_range, std::invalid_argument
 
 namespace Gudhi {
 
@@ -56,11 +54,21 @@ namespace persistent_cohomology {
  * and is adapted to the computation of Multi-Field Persistent Homology (MF)
  * \cite boissonnat:hal-00922572 .
  *
+ * The storage of the annotation matrix is chosen with the AnnotationMatrix template parameter:
+ * `Linked_annotation_matrix` (the default) links the cells in intrusive lists, while `Contiguous_annotation_matrix`
+ * stores the columns as sorted arrays in a single buffer, with much smaller cells, e.g.
+ * `Persistent_cohomology<Simplex_tree<>, Field_Z2, Contiguous_annotation_matrix>`.
+ *
+ * Simplices can be appended to the filtration after the computation: once they are inserted in the complex and its
+ * filtration is updated, `update_persistent_cohomology()` resumes the computation from the saved state of the
+ * annotation matrix, instead of starting over. When only the intervals born below some filtration value, or of low
+ * dimension, are needed, `compute_persistent_cohomology_up_to()` processes only the simplices that can affect them.
+ *
  * \implements PersistentHomology
  *
  */
-// TODO(CM): Memory allocation policy: classic, use a mempool, etc.
-template<class FilteredComplex, class CoefficientField>
+template<class FilteredComplex, class CoefficientField,
+         template<class, class> class AnnotationMatrix = Linked_annotation_matrix>
 class Persistent_cohomology {
  public:
   typedef FilteredComplex Complex_ds;
@@ -70,19 +78,11 @@ class Persistent_cohomology {
   typedef typename Complex_ds::Filtration_value Filtration_value;
   typedef typename CoefficientField::Element Arith_element;
   // Compressed Annotation Matrix types:
+  typedef AnnotationMatrix<Simplex_key, CoefficientField> Cam;
   // Column type
-  typedef Persistent_cohomology_column<Simplex_key, Arith_element> Column;  // contains 1 set_hook
-  // Cell type
-  typedef typename Column::Cell Cell;   // contains 2 list_hooks
-  // Remark: constant_time_size must be false because base_hook_cam_h has auto_unlink link_mode
-  typedef boost::intrusive::list<Cell,
-      boost::intrusive::constant_time_size<false>,
-      boost::intrusive::base_hook<base_hook_cam_h> > Hcell;
-
-  typedef boost::intrusive::set<Column,
-      boost::intrusive::constant_time_size<false> > Cam;
+  typedef typename Cam::Column Column;
   // Sparse column type for the annotation of the boundary of an element.
-  typedef std::vector<std::pair<Simplex_key, Arith_element> > A_ds_type;
+  typedef typename Cam::A_ds_type A_ds_type;
   // Persistent interval type. The Arith_element field is used for the multi-field framework.
   typedef std::tuple<Simplex_handle, Simplex_handle, Arith_element> Persistent_interval;
 
@@ -101,13 +101,16 @@ class Persistent_cohomology {
         ds_parent_(num_simplices_),                      // union-find
         ds_repr_(num_simplices_, NULL),                  // union-find -> annotation vectors
         dsets_(&ds_rank_[0], &ds_parent_[0]),            // union-find
-        cam_(),                                          // collection of annotation vectors
-        zero_cocycles_(),                                // union-find -> Simplex_key of creator for 0-homology
-        transverse_idx_(),                               // key -> row
+        cam_(num_simplices_),                            // collection of annotation vectors, and rows
+        zero_cocycles_(num_simplices_, cpx.null_key()),  // union-find -> Simplex_key of creator for 0-homology
+        killers_(num_simplices_, false),
         persistent_pairs_(),
         interval_length_policy(&cpx, 0),
-        column_pool_(),  // memory pools for the CAM
-        cell_pool_() {
+        persistence_dim_max_(false),
+        dim_max_limit_(std::numeric_limits<int>::max()),
+        num_processed_(0),
+        finite_intervals_(),
+        delayed_creators_() {
     if (cpx_->num_simplices() > std::numeric_limits<Simplex_key>::max()) {
       // num_simplices must be strictly lower than the limit, because a value is reserved for null_key.
       throw std::out_of_range("The number of simplices is more than Simplex_key type numeric limit.");
@@ -130,20 +133,12 @@ class Persistent_cohomology {
    */
   Persistent_cohomology(Complex_ds& cpx, bool persistence_dim_max)
       : Persistent_cohomology(cpx) {
+    persistence_dim_max_ = persistence_dim_max;
     if (persistence_dim_max) {
       ++dim_max_;
     }
   }
 
-  ~Persistent_cohomology() {
-    // Clean the transversal lists
-    for (auto & transverse_ref : transverse_idx_) {
-      // Destruct all the cells
-      transverse_ref.second.row_->clear_and_dispose([&](Cell*p){p->~Cell();});
-      delete transverse_ref.second.row_;
-    }
-  }
-
  private:
   struct length_interval {
     length_interval(Complex_ds * cpx, Filtration_value min_length)
@@ -185,41 +180,186 @@ class Persistent_cohomology {
     interval_length_policy.set_length(min_interval_length);
     // Compute all finite intervals
     for (auto sh : cpx_->filtration_simplex_range()) {
+      update_cohomology_groups(sh);
+      ++num_processed_;
+    }
+    compute_persistent_pairs();
+  }
+
+  /** \brief Compute the persistent homology of the filtered simplicial complex, up to a filtration value and a
+   * dimension.
+   *
+   * The computation stops at the first simplex of filtration value greater than max_filtration, so that the intervals
+   * still alive at max_filtration are infinite. Only the persistent homology of dimension at most max_dimension is
+   * computed: the simplices of dimension greater than max_dimension + 1 are not processed, and no annotation is built
+   * for the simplices of dimension max_dimension + 1.
+   *
+   * @param[in] max_filtration the computation discards all the simplices of filtration value greater than
+   *                           max_filtration
+   * @param[in] max_dimension the maximal dimension of the computed persistent homology, nonnegative
+   * @param[in] min_interval_length the computation discards all intervals of length
+   *                                less or equal than min_interval_length
+   *
+   * Assumes that the filtration provided by the simplicial complex is
+   * valid. Undefined behavior otherwise. */
+  void compute_persistent_cohomology_up_to(Filtration_value max_filtration, int max_dimension,
+                                           Filtration_value min_interval_length = 0) {
+    interval_length_policy.set_length(min_interval_length);
+    dim_max_limit_ = max_dimension + 1;
+    dim_max_ = (std::min)(dim_max_, dim_max_limit_);
+    for (auto sh : cpx_->filtration_simplex_range()) {
+      if (cpx_->filtration(sh) > max_filtration) {
+        break;
+      }
+      update_cohomology_groups(sh);
+      ++num_processed_;
+    }
+    compute_persistent_pairs();
+  }
+
+  /** \brief Updates the persistent homology after the insertion of new simplices at the end of the filtration.
+   *
+   * The new simplices must have been inserted in the complex, and its filtration updated (e.g. with
+   * `Simplex_tree::initialize_filtration()`), after a call to compute_persistent_cohomology(). They must all come
+   * after the previous simplices in the new filtration order, which is the case if their filtration values are
+   * strictly greater. Only the new simplices, and the previous ones left out by
+   * compute_persistent_cohomology_up_to() because of their filtration value, are processed, with the same
+   * min_interval_length and maximal dimension. get_persistent_pairs() then returns the intervals of the whole
+   * filtration.
+   *
+   * @exception std::invalid_argument In case a previous simplex comes after a new one in the filtration.
+   * @exception std::out_of_range In case the number of simplices is more than Simplex_key type numeric limit. */
+  void update_persistent_cohomology() {
+    std::size_t num_simplices = cpx_->num_simplices();
+    if (num_simplices > std::numeric_limits<Simplex_key>::max()) {
+      throw std::out_of_range("The number of simplices is more than Simplex_key type numeric limit.");
+    }
+    // Check the order, before anything is modified: the previous simplices, killers included, keep their key, equal
+    // to their position, so that each of the first num_simplices_ positions must hold the previous simplex of its key.
+    std::size_t position = 0;
+    for (auto sh : cpx_->filtration_simplex_range()) {
+      if (position >= num_simplices_) break;
+      if (cpx_->key(sh) != static_cast<Simplex_key>(position)) {
+        throw std::invalid_argument("The new simplices must come after the previous ones in the filtration.");
+      }
+      ++position;
+    }
+    std::size_t old_num_simplices = num_simplices_;
+    num_simplices_ = num_simplices;
+    ds_rank_.resize(num_simplices_);
+    ds_parent_.resize(num_simplices_);
+    ds_repr_.resize(num_simplices_, NULL);
+    // The vectors may have been moved in memory.
+    dsets_ = boost::disjoint_sets<int *, Simplex_key *>(ds_rank_.data(), ds_parent_.data());
+    cam_.resize(num_simplices_);
+    zero_cocycles_.resize(num_simplices_, cpx_->null_key());
+    killers_.resize(num_simplices_, false);
+
+    int dim_max = (std::min)(static_cast<int>(cpx_->dimension()) + (persistence_dim_max_ ? 1 : 0), dim_max_limit_);
+    if (dim_max > dim_max_) {
+      create_delayed_cocycles(num_processed_, dim_max);
+    }
+
+    position = 0;
+    for (auto sh : cpx_->filtration_simplex_range()) {
+      if (position >= old_num_simplices) {
+        Simplex_key key = static_cast<Simplex_key>(position);
+        cpx_->assign_key(sh, key);
+        dsets_.make_set(key);
+      }
+      if (position >= num_processed_) {
+        update_cohomology_groups(sh);
+      }
+      ++position;
+    }
+    num_processed_ = num_simplices_;
+    compute_persistent_pairs();
+  }
+
+ private:
+  /* Update the cohomology groups under the insertion of sigma, whose key is set. The simplices of dimension greater
+   * than dim_max_ cannot change the cohomology groups of dimension less than dim_max_. */
+  void update_cohomology_groups(Simplex_handle sigma) {
+    int dim_simplex = cpx_->dimension(sigma);
+    if (dim_simplex > dim_max_) {
+      return;
+    }
+    switch (dim_simplex) {
+      case 0:
+        break;
+      case 1:
+        update_cohomology_groups_edge(sigma);
+        break;
+      default:
+        update_cohomology_groups(sigma, dim_simplex);
+        break;
+    }
+  }
+
+  /* Raises dim_max_ to dim_max, and creates the cocycles of the simplices among the num_simplices first ones that were
+   * creators in dimension [max(dim_max_, 1), dim_max). They were not created because the cohomology of dimension
+   * dim_max_ was not computed, but no cofaces of these simplices were inserted after them, so that their cocycle is
+   * the one they would have had. */
+  void create_delayed_cocycles(std::size_t num_simplices, int dim_max) {
+    for (std::size_t key = 0; key < num_simplices; ++key) {
+      Simplex_handle sh = cpx_->simplex(key);
       int dim_simplex = cpx_->dimension(sh);
-      switch (dim_simplex) {
-        case 0:
-          break;
-        case 1:
-          update_cohomology_groups_edge(sh);
-          break;
-        default:
-          update_cohomology_groups(sh, dim_simplex);
-          break;
+      // The vertices are not in the annotation matrix, nor the killers.
+      if (dim_simplex == 0 || dim_simplex < dim_max_ || dim_simplex >= dim_max || killers_[key])
+        continue;
+      // Only the creators in a strict subset of the fields are recorded, with the product of their characteristics.
+      auto delayed = std::lower_bound(delayed_creators_.begin(), delayed_creators_.end(), key,
+                                      [](std::pair<Simplex_key, Arith_element> const& creator, std::size_t k) {
+                                        return creator.first < k;
+                                      });
+      if (delayed != delayed_creators_.end() && delayed->first == key) {
+        create_cocycle(sh, coeff_field_.multiplicative_identity(delayed->second), delayed->second);
+      } else {
+        create_cocycle(sh, coeff_field_.multiplicative_identity(), coeff_field_.characteristic());
       }
     }
+    delayed_creators_.erase(std::remove_if(delayed_creators_.begin(), delayed_creators_.end(),
+                                           [&](std::pair<Simplex_key, Arith_element> const& creator) {
+                                             int dim_creator = cpx_->dimension(cpx_->simplex(creator.first));
+                                             return dim_creator < dim_max;
+                                           }),
+                            delayed_creators_.end());
+    dim_max_ = dim_max;
+  }
+
+  /* Fills persistent_pairs_ with the finite intervals found so far, and the infinite ones. */
+  void compute_persistent_pairs() {
+    persistent_pairs_.clear();
+    for (auto const& interval : finite_intervals_) {
+      persistent_pairs_.emplace_back(cpx_->simplex(get<0>(interval)), cpx_->simplex(get<1>(interval)),
+                                     get<2>(interval));
+    }
     // Compute infinite intervals of dimension 0
     Simplex_key key;
     for (auto v_sh : cpx_->skeleton_simplex_range(0)) {  // for all 0-dimensional simplices
       key = cpx_->key(v_sh);
 
-      if (ds_parent_[key] == key  // root of its tree
-      && zero_cocycles_.find(key) == zero_cocycles_.end()) {
+      if (static_cast<std::size_t>(key) < num_processed_ && ds_parent_[key] == key  // processed, and root of its tree
+      && zero_cocycles_[key] == cpx_->null_key()) {
         persistent_pairs_.emplace_back(
             cpx_->simplex(key), cpx_->null_simplex(), coeff_field_.characteristic());
       }
     }
     for (auto zero_idx : zero_cocycles_) {
-      persistent_pairs_.emplace_back(
-          cpx_->simplex(zero_idx.second), cpx_->null_simplex(), coeff_field_.characteristic());
+      if (zero_idx != cpx_->null_key()) {
+        persistent_pairs_.emplace_back(
+            cpx_->simplex(zero_idx), cpx_->null_simplex(), coeff_field_.characteristic());
+      }
     }
     // Compute infinite interval of dimension > 0
-    for (auto cocycle : transverse_idx_) {
-      persistent_pairs_.emplace_back(
-          cpx_->simplex(cocycle.first), cpx_->null_simplex(), cocycle.second.characteristics_);
+    for (std::size_t key = 0; key < num_simplices_; ++key) {
+      if (cam_.has_cocycle(key)) {
+        persistent_pairs_.emplace_back(
+            cpx_->simplex(key), cpx_->null_simplex(), cam_.characteristics(key));
+      }
     }
   }
 
- private:
   /** \brief Update the cohomology groups under the insertion of an edge.
    *
    * The 0-homology is maintained with a simple Union-Find data structure, which
@@ -236,65 +376,52 @@ class Persistent_cohomology {
       // Keys of the simplices which created the connected components containing
       // respectively u and v.
       Simplex_key idx_coc_u, idx_coc_v;
-      auto map_it_u = zero_cocycles_.find(ku);
       // If the index of the cocycle representing the class is already ku.
-      if (map_it_u == zero_cocycles_.end()) {
+      if (zero_cocycles_[ku] == cpx_->null_key()) {
         idx_coc_u = ku;
       } else {
-        idx_coc_u = map_it_u->second;
+        idx_coc_u = zero_cocycles_[ku];
       }
 
-      auto map_it_v = zero_cocycles_.find(kv);
       // If the index of the cocycle representing the class is already kv.
-      if (map_it_v == zero_cocycles_.end()) {
+      if (zero_cocycles_[kv] == cpx_->null_key()) {
         idx_coc_v = kv;
       } else {
-        idx_coc_v = map_it_v->second;
+        idx_coc_v = zero_cocycles_[kv];
       }
 
       if (cpx_->filtration(cpx_->simplex(idx_coc_u))
           < cpx_->filtration(cpx_->simplex(idx_coc_v))) {  // Kill cocycle [idx_coc_v], which is younger.
         if (interval_length_policy(cpx_->simplex(idx_coc_v), sigma)) {
-          persistent_pairs_.emplace_back(
-              cpx_->simplex(idx_coc_v), sigma, coeff_field_.characteristic());
+          finite_intervals_.emplace_back(idx_coc_v, cpx_->key(sigma), coeff_field_.characteristic());
         }
         // Maintain the index of the 0-cocycle alive.
-        if (kv != idx_coc_v) {
-          zero_cocycles_.erase(map_it_v);
-        }
+        zero_cocycles_[kv] = cpx_->null_key();
         if (kv == dsets_.find_set(kv)) {
-          if (ku != idx_coc_u) {
-            zero_cocycles_.erase(map_it_u);
-          }
+          zero_cocycles_[ku] = cpx_->null_key();
           zero_cocycles_[kv] = idx_coc_u;
         }
       } else {  // Kill cocycle [idx_coc_u], which is younger.
         if (interval_length_policy(cpx_->simplex(idx_coc_u), sigma)) {
-          persistent_pairs_.emplace_back(
-              cpx_->simplex(idx_coc_u), sigma, coeff_field_.characteristic());
+          finite_intervals_.emplace_back(idx_coc_u, cpx_->key(sigma), coeff_field_.characteristic());
         }
         // Maintain the index of the 0-cocycle alive.
-        if (ku != idx_coc_u) {
-          zero_cocycles_.erase(map_it_u);
-        }
+        zero_cocycles_[ku] = cpx_->null_key();
         if (ku == dsets_.find_set(ku)) {
-          if (kv != idx_coc_v) {
-            zero_cocycles_.erase(map_it_v);
-          }
+          zero_cocycles_[kv] = cpx_->null_key();
           zero_cocycles_[ku] = idx_coc_v;
         }
       }
-      cpx_->assign_key(sigma, cpx_->null_key());
+      killers_[cpx_->key(sigma)] = true;
     } else if (dim_max_ > 1) {  // If ku == kv, same connected component: create a 1-cocycle class.
       create_cocycle(sigma, coeff_field_.multiplicative_identity(), coeff_field_.characteristic());
     }
   }
 
   /*
-   * Compute the annotation of the boundary of a simplex.
+   * Compute the annotation of the boundary of a simplex, as a sparse vector sorted by key.
    */
-  void annotation_of_the_boundary(
-      std::map<Simplex_key, Arith_element> & map_a_ds, Simplex_handle sigma) {
+  void annotation_of_the_boundary(A_ds_type & a_ds, Simplex_handle sigma) {
     // traverses the boundary of sigma, keeps track of the annotation vectors,
     // with multiplicity. We used to sum the coefficients directly in
     // annotations_in_boundary by using a map, we now do it later.
@@ -308,7 +435,7 @@ class Persistent_cohomology {
       Simplex_handle sh = osh.first;
       int sign = osh.second;
       key = cpx_->key(sh);
-      if (key != cpx_->null_key()) {  // A simplex with null_key is a killer, and have null annotation
+      if (!killers_[key]) {  // A killer has a null annotation
         // Find its annotation vector
         curr_col = ds_repr_[dsets_.find_set(key)];
         if (curr_col != NULL) {  // and insert it in annotations_in_boundary with multyiplicative factor "sign".
@@ -321,10 +448,9 @@ class Persistent_cohomology {
     std::sort(annotations_in_boundary.begin(), annotations_in_boundary.end(),
               [](annotation_t const& a, annotation_t const& b) { return a.first < b.first; });
 
-    // Sum the annotations with multiplicity, using a map<key,coeff>
-    // to represent a sparse vector.
-    std::pair<typename std::map<Simplex_key, Arith_element>::iterator, bool> result_insert_a_ds;
-
+    // Gather the cells of the annotations with multiplicity, sort them by key and sum the coefficients of each key.
+    // a_ds is reused from one simplex to the next, which avoids allocating a node per cell as a map would.
+    a_ds.clear();
     for (auto ann_it = annotations_in_boundary.begin(); ann_it != annotations_in_boundary.end(); /**/) {
       Column* col = ann_it->first;
       int mult = ann_it->second;
@@ -333,21 +459,37 @@ class Persistent_cohomology {
       }
       // The following test is just a heuristic, it is not required, and it is fine that is misses p == 0.
       if (mult != coeff_field_.additive_identity()) {  // For all columns in the boundary,
-        for (auto cell_ref : col->col_) {  // insert every cell in map_a_ds with multiplicity
-          Arith_element w_y = coeff_field_.times(cell_ref.coefficient_, mult);  // coefficient * multiplicity
+        // Multiplicity as an element of the field
+        Arith_element w = coeff_field_.times(coeff_field_.multiplicative_identity(), mult);
+        cam_.for_each_cell(*col, [&](Simplex_key cell_key, Arith_element coefficient) {
+          // insert every cell in a_ds with multiplicity: coefficient * multiplicity
+          Arith_element w_y = coeff_field_.plus_times_equal(coeff_field_.additive_identity(), coefficient, w);
 
           if (w_y != coeff_field_.additive_identity()) {  // if != 0
-            result_insert_a_ds = map_a_ds.insert(std::pair<Simplex_key, Arith_element>(cell_ref.key_, w_y));
-            if (!(result_insert_a_ds.second)) {  // if cell_ref.key_ already a Key in map_a_ds
-              result_insert_a_ds.first->second = coeff_field_.plus_equal(result_insert_a_ds.first->second, w_y);
-              if (result_insert_a_ds.first->second == coeff_field_.additive_identity()) {
-                map_a_ds.erase(result_insert_a_ds.first);
-              }
-            }
+            a_ds.emplace_back(cell_key, w_y);
           }
-        }
+        });
       }
     }
+    std::sort(a_ds.begin(), a_ds.end(),
+              [](std::pair<Simplex_key, Arith_element> const& a, std::pair<Simplex_key, Arith_element> const& b) {
+                return a.first < b.first;
+              });
+
+    auto out_it = a_ds.begin();
+    for (auto a_ds_it = a_ds.begin(); a_ds_it != a_ds.end(); /**/) {
+      Simplex_key key = a_ds_it->first;
+      Arith_element sum = a_ds_it->second;
+      while (++a_ds_it != a_ds.end() && a_ds_it->first == key) {
+        sum = coeff_field_.plus_equal(sum, a_ds_it->second);
+      }
+      if (sum != coeff_field_.additive_identity()) {
+        out_it->first = key;
+        out_it->second = sum;
+        ++out_it;
+      }
+    }
+    a_ds.erase(out_it, a_ds.end());
   }
 
   /*
@@ -355,23 +497,15 @@ class Persistent_cohomology {
    */
   void update_cohomology_groups(Simplex_handle sigma, int dim_sigma) {
 // Compute the annotation of the boundary of sigma:
-    std::map<Simplex_key, Arith_element> map_a_ds;
-    annotation_of_the_boundary(map_a_ds, sigma);
+    thread_local A_ds_type a_ds;  // admits reverse iterators
+    annotation_of_the_boundary(a_ds, sigma);
 // Update the cohomology groups:
-    if (map_a_ds.empty()) {  // sigma is a creator in all fields represented in coeff_field_
+    if (a_ds.empty()) {  // sigma is a creator in all fields represented in coeff_field_
       if (dim_sigma < dim_max_) {
         create_cocycle(sigma, coeff_field_.multiplicative_identity(),
                        coeff_field_.characteristic());
       }
     } else {        // sigma is a destructor in at least a field in coeff_field_
-      // Convert map_a_ds to a vector
-      A_ds_type a_ds;  // admits reverse iterators
-      for (auto map_a_ds_ref : map_a_ds) {
-        a_ds.push_back(
-            std::pair<Simplex_key, Arith_element>(map_a_ds_ref.first,
-                                                  map_a_ds_ref.second));
-      }
-
       Arith_element inv_x, charac;
       Arith_element prod = coeff_field_.characteristic();  // Product of characteristic of the fields
       for (auto a_ds_rit = a_ds.rbegin();
@@ -384,9 +518,16 @@ class Persistent_cohomology {
           prod /= charac;
         }
       }
-      if (prod != coeff_field_.multiplicative_identity()
-          && dim_sigma < dim_max_) {
-        create_cocycle(sigma, coeff_field_.multiplicative_identity(prod), prod);
+      if (prod == coeff_field_.multiplicative_identity()) {
+        // sigma is a killer in all the fields. It keeps its key, as update_persistent_cohomology() relies on it.
+        killers_[cpx_->key(sigma)] = true;
+      } else {
+        if (dim_sigma < dim_max_) {
+          create_cocycle(sigma, coeff_field_.multiplicative_identity(prod), prod);
+        } else if (prod != coeff_field_.characteristic()) {
+          // Needed by update_persistent_cohomology() if the dimension of the complex grows.
+          delayed_creators_.emplace_back(cpx_->key(sigma), prod);
+        }
       }
     }
   }
@@ -401,19 +542,8 @@ class Persistent_cohomology {
   void create_cocycle(Simplex_handle sigma, Arith_element x,
                       Arith_element charac) {
     Simplex_key key = cpx_->key(sigma);
-    // Create a column containing only one cell,
-    Column * new_col = column_pool_.construct(key);
-    Cell * new_cell = cell_pool_.construct(key, x, new_col);
-    new_col->col_.push_back(*new_cell);
-    // and insert it in the matrix, in constant time thanks to the hint cam_.end().
-    // Indeed *new_col has the biggest lexicographic value because key is the
-    // biggest key used so far.
-    cam_.insert(cam_.end(), *new_col);
-    // Update the disjoint sets data structure.
-    Hcell * new_hcell = new Hcell;
-    new_hcell->push_back(*new_cell);
-    transverse_idx_[key] = cocycle(charac, new_hcell);  // insert the new row
-    ds_repr_[key] = new_col;
+    // Create a column containing only one cell, and the corresponding row.
+    ds_repr_[key] = cam_.create_cocycle(key, x, charac);
   }
 
   /*  \brief Destroy a cocycle class.
@@ -429,135 +559,25 @@ class Persistent_cohomology {
                        Arith_element charac) {
     // Create a finite persistent interval for which the interval exists
     if (interval_length_policy(cpx_->simplex(death_key), sigma)) {
-      persistent_pairs_.emplace_back(cpx_->simplex(death_key)  // creator
-          , sigma                                              // destructor
-          , charac);                                           // fields
-    }
-
-    auto death_key_row = transverse_idx_.find(death_key);  // Find the beginning of the row.
-    std::pair<typename Cam::iterator, bool> result_insert_cam;
-
-    auto row_cell_it = death_key_row->second.row_->begin();
-
-    while (row_cell_it != death_key_row->second.row_->end()) {  // Traverse all cells in
-      // the row at index death_key.
-      Arith_element w = coeff_field_.times_minus(inv_x, row_cell_it->coefficient_);
-
-      if (w != coeff_field_.additive_identity()) {
-        Column * curr_col = row_cell_it->self_col_;
-        ++row_cell_it;
-        // Disconnect the column from the rows in the CAM.
-        for (auto& col_cell : curr_col->col_) {
-          col_cell.base_hook_cam_h::unlink();
-        }
-
-        // Remove the column from the CAM before modifying its value
-        cam_.erase(cam_.iterator_to(*curr_col));
-        // Proceed to the reduction of the column
-        plus_equal_column(*curr_col, a_ds, w);
-
-        if (curr_col->col_.empty()) {  // If the column is null
-          ds_repr_[curr_col->class_key_] = NULL;
-          column_pool_.destroy(curr_col);  // delete curr_col;
-        } else {
-          // Find whether the column obtained is already in the CAM
-          result_insert_cam = cam_.insert(*curr_col);
-          if (result_insert_cam.second) {  // If it was not in the CAM before: insertion has succeeded
-            for (auto& col_cell : curr_col->col_) {
-              // re-establish the row links
-              transverse_idx_[col_cell.key_].row_->push_front(col_cell);
-            }
-          } else {  // There is already an identical column in the CAM:
-            // merge two disjoint sets.
-            dsets_.link(curr_col->class_key_,
-                        result_insert_cam.first->class_key_);
-
-            Simplex_key key_tmp = dsets_.find_set(curr_col->class_key_);
-            ds_repr_[key_tmp] = &(*(result_insert_cam.first));
-            result_insert_cam.first->class_key_ = key_tmp;
-            // intrusive containers don't own their elements, we have to release them manually
-            curr_col->col_.clear_and_dispose([&](Cell*p){cell_pool_.destroy(p);});
-            column_pool_.destroy(curr_col);  // delete curr_col;
-          }
-        }
-      } else {
-        ++row_cell_it;
-      }  // If w == 0, pass.
-    }
-
-    // Because it is a killer simplex, set the data of sigma to null_key().
-    if (charac == coeff_field_.characteristic()) {
-      cpx_->assign_key(sigma, cpx_->null_key());
-    }
-    if (death_key_row->second.characteristics_ == charac) {
-      delete death_key_row->second.row_;
-      transverse_idx_.erase(death_key_row);
-    } else {
-      death_key_row->second.characteristics_ /= charac;
-    }
+      finite_intervals_.emplace_back(death_key  // creator
+          , cpx_->key(sigma)                    // destructor
+          , charac);                            // fields
+    }
+
+    cam_.destroy_cocycle(death_key, a_ds, inv_x, charac, coeff_field_,
+                         [&](Column& null_col) {  // If the column is null
+                           ds_repr_[null_col.class_key_] = NULL;
+                         },
+                         [&](Column& col, Column& same_col) {  // There is already an identical column in the CAM:
+                           // merge two disjoint sets.
+                           dsets_.link(col.class_key_, same_col.class_key_);
+
+                           Simplex_key key_tmp = dsets_.find_set(col.class_key_);
+                           ds_repr_[key_tmp] = &same_col;
+                           same_col.class_key_ = key_tmp;
+                         });
   }
 
-  /*
-   * Assign:    target <- target + w * other.
-   */
-  void plus_equal_column(Column & target, A_ds_type const& other  // value_type is pair<Simplex_key,Arith_element>
-                         , Arith_element w) {
-    auto target_it = target.col_.begin();
-    auto other_it = other.begin();
-    while (target_it != target.col_.end() && other_it != other.end()) {
-      if (target_it->key_ < other_it->first) {
-        ++target_it;
-      } else {
-        if (target_it->key_ > other_it->first) {
-          Cell * cell_tmp = cell_pool_.construct(Cell(other_it->first   // key
-              , coeff_field_.additive_identity(), &target));
-
-          cell_tmp->coefficient_ = coeff_field_.plus_times_equal(cell_tmp->coefficient_, other_it->second, w);
-
-          target.col_.insert(target_it, *cell_tmp);
-
-          ++other_it;
-        } else {  // it1->key == it2->key
-          // target_it->coefficient_ <- target_it->coefficient_ + other_it->second * w
-          target_it->coefficient_ = coeff_field_.plus_times_equal(target_it->coefficient_, other_it->second, w);
-          if (target_it->coefficient_ == coeff_field_.additive_identity()) {
-            auto tmp_it = target_it;
-            ++target_it;
-            ++other_it;   // iterators remain valid
-            Cell * tmp_cell_ptr = &(*tmp_it);
-            target.col_.erase(tmp_it);  // removed from column
-
-            cell_pool_.destroy(tmp_cell_ptr);  // delete from memory
-          } else {
-            ++target_it;
-            ++other_it;
-          }
-        }
-      }
-    }
-    while (other_it != other.end()) {
-      Cell * cell_tmp = cell_pool_.construct(Cell(other_it->first, coeff_field_.additive_identity(), &target));
-      cell_tmp->coefficient_ = coeff_field_.plus_times_equal(cell_tmp->coefficient_, other_it->second, w);
-      target.col_.insert(target.col_.end(), *cell_tmp);
-
-      ++other_it;
-    }
-  }
-
-  /*
-   * Compare two intervals by length.
-   */
-  struct cmp_intervals_by_length {
-    explicit cmp_intervals_by_length(Complex_ds * sc)
-        : sc_(sc) {
-    }
-    bool operator()(const Persistent_interval & p1, const Persistent_interval & p2) {
-      return (sc_->filtration(get < 1 > (p1)) - sc_->filtration(get < 0 > (p1))
-          > sc_->filtration(get < 1 > (p2)) - sc_->filtration(get < 0 > (p2)));
-    }
-    Complex_ds * sc_;
-  };
-
  public:
   /** \brief Output the persistence diagram in ostream.
    *
@@ -570,55 +590,20 @@ class Persistent_cohomology {
    * feature exists in homology with Z/piZ coefficients.
    */
   void output_diagram(std::ostream& ostream = std::cout) {
-    cmp_intervals_by_length cmp(cpx_);
-    std::sort(std::begin(persistent_pairs_), std::end(persistent_pairs_), cmp);
-    bool has_infinity = std::numeric_limits<Filtration_value>::has_infinity;
-    for (auto pair : persistent_pairs_) {
-      // Special case on windows, inf is "1.#INF" (cf. unitary tests and R package TDA)
-      if (has_infinity && cpx_->filtration(get<1>(pair)) == std::numeric_limits<Filtration_value>::infinity()) {
-        ostream << get<2>(pair) << "  " << cpx_->dimension(get<0>(pair)) << " "
-          << cpx_->filtration(get<0>(pair)) << " inf " << std::endl;
-      } else {
-        ostream << get<2>(pair) << "  " << cpx_->dimension(get<0>(pair)) << " "
-          << cpx_->filtration(get<0>(pair)) << " "
-          << cpx_->filtration(get<1>(pair)) << " " << std::endl;
-      }
-    }
+    Intervals::output_diagram(cpx_, persistent_pairs_, ostream, true);
   }
 
+  /** \brief Writes the persistence diagram in the file diagram_name, in the format of output_diagram without the
+   * characteristic of the fields. */
   void write_output_diagram(std::string diagram_name) {
-    std::ofstream diagram_out(diagram_name.c_str());
-    cmp_intervals_by_length cmp(cpx_);
-    std::sort(std::begin(persistent_pairs_), std::end(persistent_pairs_), cmp);
-    bool has_infinity = std::numeric_limits<Filtration_value>::has_infinity;
-    for (auto pair : persistent_pairs_) {
-      // Special case on windows, inf is "1.#INF"
-      if (has_infinity && cpx_->filtration(get<1>(pair)) == std::numeric_limits<Filtration_value>::infinity()) {
-        diagram_out << cpx_->dimension(get<0>(pair)) << " "
-              << cpx_->filtration(get<0>(pair)) << " inf" << std::endl;
-      } else {
-        diagram_out << cpx_->dimension(get<0>(pair)) << " "
-              << cpx_->filtration(get<0>(pair)) << " "
-              << cpx_->filtration(get<1>(pair)) << std::endl;
-      }
-    }
+    Intervals::write_output_diagram(cpx_, persistent_pairs_, diagram_name);
   }
 
   /** @brief Returns Betti numbers.
    * @return A vector of Betti numbers.
    */
   std::vector<int> betti_numbers() const {
-    // Init Betti numbers vector with zeros until Simplicial complex dimension
-    std::vector<int> betti_numbers(dim_max_, 0);
-
-    for (auto pair : persistent_pairs_) {
-      // Count never ended persistence intervals
-      if (cpx_->null_simplex() == get<1>(pair)) {
-        // Increment corresponding betti number
-        betti_numbers[cpx_->dimension(get<0>(pair))] += 1;
-      }
-    }
-    return betti_numbers;
+    return Intervals::betti_numbers(cpx_, persistent_pairs_, dim_max_);
   }
 
   /** @brief Returns the Betti number of the dimension passed by parameter.
@@ -627,18 +612,7 @@ class Persistent_cohomology {
    *
    */
   int betti_number(int dimension) const {
-    int betti_number = 0;
-
-    for (auto pair : persistent_pairs_) {
-      // Count never ended persistence intervals
-      if (cpx_->null_simplex() == get<1>(pair)) {
-        if (cpx_->dimension(get<0>(pair)) == dimension) {
-          // Increment betti number found
-          ++betti_number;
-        }
-      }
-    }
-    return betti_number;
+    return Intervals::betti_number(cpx_, persistent_pairs_, dimension);
   }
 
   /** @brief Returns the persistent Betti numbers.
@@ -647,19 +621,7 @@ class Persistent_cohomology {
    * @return A vector of persistent Betti numbers.
    */
   std::vector<int> persistent_betti_numbers(Filtration_value from, Filtration_value to) const {
-    // Init Betti numbers vector with zeros until Simplicial complex dimension
-    std::vector<int> betti_numbers(dim_max_, 0);
-    for (auto pair : persistent_pairs_) {
-      // Count persistence intervals that covers the given interval
-      // null_simplex test : if the function is called with to=+infinity, we still get something useful. And it will
-      // still work if we change the complex filtration function to reject null simplices.
-      if (cpx_->filtration(get<0>(pair)) <= from &&
-          (get<1>(pair) == cpx_->null_simplex() || cpx_->filtration(get<1>(pair)) > to)) {
-        // Increment corresponding betti number
-        betti_numbers[cpx_->dimension(get<0>(pair))] += 1;
-      }
-    }
-    return betti_numbers;
+    return Intervals::persistent_betti_numbers(cpx_, persistent_pairs_, dim_max_, from, to);
   }
 
   /** @brief Returns the persistent Betti number of the dimension passed by parameter.
@@ -669,21 +631,7 @@ class Persistent_cohomology {
    * @return Persistent Betti number of the given dimension
    */
   int persistent_betti_number(int dimension, Filtration_value from, Filtration_value to) const {
-    int betti_number = 0;
-
-    for (auto pair : persistent_pairs_) {
-      // Count persistence intervals that covers the given interval
-      // null_simplex test : if the function is called with to=+infinity, we still get something useful. And it will
-      // still work if we change the complex filtration function to reject null simplices.
-      if (cpx_->filtration(get<0>(pair)) <= from &&
-          (get<1>(pair) == cpx_->null_simplex() || cpx_->filtration(get<1>(pair)) > to)) {
-        if (cpx_->dimension(get<0>(pair)) == dimension) {
-          // Increment betti number found
-          ++betti_number;
-        }
-      }
-    }
-    return betti_number;
+    return Intervals::persistent_betti_number(cpx_, persistent_pairs_, dimension, from, to);
   }
 
   /** @brief Returns the persistent pairs.
@@ -700,33 +648,12 @@ class Persistent_cohomology {
    */
   std::vector< std::pair< Filtration_value , Filtration_value > >
   intervals_in_dimension(int dimension) {
-    std::vector< std::pair< Filtration_value , Filtration_value > > result;
-    // auto && pair, to avoid unnecessary copying
-    for (auto && pair : persistent_pairs_) {
-      if (cpx_->dimension(get<0>(pair)) == dimension) {
-        result.emplace_back(cpx_->filtration(get<0>(pair)), cpx_->filtration(get<1>(pair)));
-      }
-    }
-    return result;
+    return Intervals::intervals_in_dimension(cpx_, persistent_pairs_, dimension);
   }
 
  private:
-  /*
-   * Structure representing a cocycle.
-   */
-  struct cocycle {
-    cocycle()
-        : row_(nullptr),
-          characteristics_() {
-    }
-    cocycle(Arith_element characteristics, Hcell * row)
-        : row_(row),
-          characteristics_(characteristics) {
-    }
-
-    Hcell * row_;                    // points to the corresponding row in the CAM
-    Arith_element characteristics_;  // product of field characteristics for which the cocycle exist
-  };
+  // Outputs of the intervals, shared with Persistent_homology_matrix_reduction.
+  typedef internal::Persistent_intervals<Complex_ds, Persistent_interval> Intervals;
 
  public:
   Complex_ds * cpx_;
@@ -742,20 +669,31 @@ class Persistent_cohomology {
   std::vector<Simplex_key> ds_parent_;
   std::vector<Column *> ds_repr_;
   boost::disjoint_sets<int *, Simplex_key *> dsets_;
-  /* The compressed annotation matrix fields.*/
+  /* The compressed annotation matrix.*/
   Cam cam_;
-  /*  Dictionary establishing the correspondance between the Simplex_key of
-   * the root vertex in the union-find ds and the Simplex_key of the vertex which
-   * created the connected component as a 0-dimension homology feature.*/
-  std::map<Simplex_key, Simplex_key> zero_cocycles_;
-  /*  Key -> row. */
-  std::map<Simplex_key, cocycle> transverse_idx_;
+  /*  Correspondance between the Simplex_key of the root vertex in the union-find
+   * ds and the Simplex_key of the vertex which created the connected component
+   * as a 0-dimension homology feature, indexed by the former. null_key() when
+   * the root vertex created the connected component itself.*/
+  std::vector<Simplex_key> zero_cocycles_;
+  /* Whether the simplex of each key is a killer in all the fields. The killers keep their key, and have a null
+   * annotation. */
+  std::vector<bool> killers_;
   /* Persistent intervals. */
   std::vector<Persistent_interval> persistent_pairs_;
   length_interval interval_length_policy;
-
-  Simple_object_pool<Column> column_pool_;
-  Simple_object_pool<Cell> cell_pool_;
+  /* Whether the persistent homology for the maximal dimension in the complex is computed. */
+  bool persistence_dim_max_;
+  /* Upper bound on dim_max_ given to compute_persistent_cohomology_up_to(). */
+  int dim_max_limit_;
+  /* Number of simplices at the beginning of the filtration processed so far. */
+  std::size_t num_processed_;
+  /* Finite persistent intervals, as the keys of their creator and destructor, which remain valid when simplices are
+   * inserted in the complex. */
+  std::vector<std::tuple<Simplex_key, Simplex_key, Arith_element> > finite_intervals_;
+  /* Simplices of dimension at least dim_max_ that were creators in some fields only, with the product of the
+   * characteristics of these fields, sorted by key. */
+  std::vector<std::pair<Simplex_key, Arith_element> > delayed_creators_;
 };
 
 }  // namespace persistent_cohomology
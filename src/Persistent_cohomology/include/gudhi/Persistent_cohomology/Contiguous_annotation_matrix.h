@@ -0,0 +1,413 @@
+/*    This file is part of the Gudhi Library. The Gudhi library
+ *    (Geometric Understanding in Higher Dimensions) is a generic C++
+ *    library for computational topology.
+ *
+ *    Author(s):       Gudhi contributors
+ *
+ *    Copyright (C) 2018 Inria
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PERSISTENT_COHOMOLOGY_CONTIGUOUS_ANNOTATION_MATRIX_H_
+#define PERSISTENT_COHOMOLOGY_CONTIGUOUS_ANNOTATION_MATRIX_H_
+
+#include <gudhi/Persistent_cohomology/Field_Z2.h>  // for Has_unit_coefficients
+#include <gudhi/Simple_object_pool.h>
+
+#include <boost/intrusive/set.hpp>
+
+#include <vector>
+#include <deque>
+#include <utility>  // for std::pair
+#include <algorithm>  // for std::lower_bound, std::sort, std::unique, std::lexicographical_compare
+#include <type_traits>  // for std::conditional
+#include <cstddef>  // for std::size_t
+
+namespace Gudhi {
+
+namespace persistent_cohomology {
+
+/** \brief Compressed annotation matrix whose columns are sorted arrays stored contiguously in an arena.
+ *
+ * \ingroup persistent_cohomology
+ *
+ * The cells of a column are consecutive in a single buffer shared by all the columns, so that adding a multiple of the
+ * annotation of a boundary to a column is a linear merge. A column that grows beyond its capacity is moved to the end
+ * of the buffer, and the buffer is compacted when more than half of it is unused. Over \f$\mathbb{Z}/2\mathbb{Z}\f$
+ * (`Field_Z2`), a cell is only a key.
+ *
+ * The rows, needed to find the columns to update when a cocycle dies, are lists of columns that may contain the key of
+ * the row: a column is added to a row when it gains the key, and the columns that lost it are skipped and eventually
+ * removed from the row. Compared to `Linked_annotation_matrix`, this uses less memory per cell and avoids a pointer
+ * chase per cell, at the price of copying the columns that are modified.
+ *
+ * \tparam SimplexKey Type of the keys of the simplices.
+ * \tparam CoefficientField Model of `CoefficientField`.
+ */
+template<typename SimplexKey, typename CoefficientField>
+class Contiguous_annotation_matrix {
+ public:
+  typedef typename CoefficientField::Element Arith_element;
+  // Sparse column type for the annotation of the boundary of an element.
+  typedef std::vector<std::pair<SimplexKey, Arith_element> > A_ds_type;
+
+ private:
+  static constexpr bool unit_coefficients = Has_unit_coefficients<CoefficientField>::value;
+  // Over Z/2Z, a cell is only a key.
+  typedef typename std::conditional<unit_coefficients, SimplexKey,
+                                    std::pair<SimplexKey, Arith_element> >::type Cell;
+
+ public:
+  /** \brief Column of the matrix: a range of the buffer of cells, sorted by increasing key.*/
+  struct Column : public boost::intrusive::set_base_hook<boost::intrusive::link_mode<boost::intrusive::normal_link> > {
+    explicit Column(SimplexKey key)
+        : class_key_(key),
+          begin_(0),
+          size_(0),
+          capacity_(0),
+          alive_(true) {
+    }
+
+    // Key of the representative simplex of the set of simplices having this column as annotation vector.
+    SimplexKey class_key_;
+    std::size_t begin_;
+    std::size_t size_;
+    std::size_t capacity_;
+    bool alive_;
+  };
+
+  /** \brief Creates an empty matrix, with a row per simplex key in [0, num_simplices).*/
+  explicit Contiguous_annotation_matrix(std::size_t num_simplices)
+      : cells_(),
+        unused_cells_(0),
+        columns_(),
+        free_columns_(),
+        cam_(Column_order(this)),
+        transverse_idx_(num_simplices),
+        next_key_(0),
+        row_pool_() {
+  }
+
+  ~Contiguous_annotation_matrix() {
+    cam_.clear();
+    for (auto & transverse_ref : transverse_idx_) {
+      if (transverse_ref.row_ != nullptr)
+        row_pool_.destroy(transverse_ref.row_);
+    }
+  }
+
+  Contiguous_annotation_matrix(const Contiguous_annotation_matrix&) = delete;
+  Contiguous_annotation_matrix& operator=(const Contiguous_annotation_matrix&) = delete;
+
+  /** \brief Calls f(key, coefficient) for every non-zero cell of the column, by increasing key.*/
+  template<class Function>
+  void for_each_cell(const Column& col, Function&& f) const {
+    for (const Cell* cell = cells_.data() + col.begin_; cell != cells_.data() + col.begin_ + col.size_; ++cell)
+      f(key_of(*cell), coefficient_of(*cell));
+  }
+
+  /** \brief Creates the cocycle of the simplex of key key, which worths x on this simplex and 0 elsewhere, and
+   * returns its column.*/
+  Column* create_cocycle(SimplexKey key, Arith_element x, Arith_element charac) {
+    Column* new_col;
+    if (free_columns_.empty()) {
+      columns_.emplace_back(key);
+      new_col = &columns_.back();
+    } else {
+      new_col = free_columns_.back();
+      free_columns_.pop_back();
+      new_col->class_key_ = key;
+      new_col->alive_ = true;
+    }
+    new_col->begin_ = cells_.size();
+    new_col->size_ = 1;
+    new_col->capacity_ = 1;
+    cells_.push_back(make_cell(key, x));
+    // If key is the biggest key used so far, the column is the biggest one. It is not the case for the delayed
+    // cocycles of the smaller keys, created when the dimension grows.
+    if (static_cast<std::size_t>(key) >= next_key_) {
+      cam_.insert(cam_.end(), *new_col);
+      next_key_ = static_cast<std::size_t>(key) + 1;
+    } else {
+      cam_.insert(*new_col);
+    }
+    Row* row = row_pool_.construct();
+    row->columns_.push_back(new_col);
+    transverse_idx_[key] = cocycle(charac, row);
+    return new_col;
+  }
+
+  /** \brief Zeroes out the row of death_key, by adding a multiple of a_ds to every column with a non-zero cell in
+   * this row, for the fields of characteristic charac.
+   *
+   * on_null(col) is called before col is destroyed because it became null, and on_merge(col, other) before col is
+   * destroyed because it became equal to the column other already in the matrix.*/
+  template<class NullColumn, class MergeColumns>
+  void destroy_cocycle(SimplexKey death_key, A_ds_type const& a_ds, Arith_element inv_x, Arith_element charac,
+                       CoefficientField& coeff_field, NullColumn&& on_null, MergeColumns&& on_merge) {
+    cocycle& death_key_cocycle = transverse_idx_[death_key];
+    Row& death_key_row = *death_key_cocycle.row_;
+    // The reduction zeroes out death_key in the columns, it never adds it, so the row does not gain columns during the
+    // traversal.
+    std::vector<Column*> row_columns;
+    row_columns.swap(death_key_row.columns_);
+    std::sort(row_columns.begin(), row_columns.end());
+    row_columns.erase(std::unique(row_columns.begin(), row_columns.end()), row_columns.end());
+
+    for (Column* curr_col : row_columns) {
+      const Cell* cell = find_cell(*curr_col, death_key);
+      if (cell == nullptr)
+        continue;  // The column lost death_key, or was destroyed
+      Arith_element w = coeff_field.times_minus(inv_x, coefficient_of(*cell));
+      if (w == coeff_field.additive_identity()) {
+        death_key_row.columns_.push_back(curr_col);
+        continue;
+      }
+      // Remove the column from the CAM before modifying its value
+      cam_.erase(cam_.iterator_to(*curr_col));
+      plus_equal_column(*curr_col, a_ds, w, coeff_field);
+      if (curr_col->size_ == 0) {  // If the column is null
+        on_null(*curr_col);
+        destroy_column(*curr_col);
+      } else {
+        auto result_insert_cam = cam_.insert(*curr_col);
+        if (result_insert_cam.second) {  // If it was not in the CAM before: insertion has succeeded
+          // With several fields, the column may still contain death_key for the other fields.
+          if (find_cell(*curr_col, death_key) != nullptr)
+            death_key_row.columns_.push_back(curr_col);
+        } else {  // There is already an identical column in the CAM: merge two disjoint sets.
+          on_merge(*curr_col, *result_insert_cam.first);
+          destroy_column(*curr_col);
+        }
+      }
+    }
+
+    if (death_key_cocycle.characteristics_ == charac) {
+      row_pool_.destroy(death_key_cocycle.row_);
+      death_key_cocycle.row_ = nullptr;
+    } else {
+      death_key_cocycle.characteristics_ /= charac;
+    }
+    compact_if_needed();
+  }
+
+  /** \brief Adds a row without cocycle for every new simplex key in [old number of simplices, num_simplices).*/
+  void resize(std::size_t num_simplices) {
+    transverse_idx_.resize(num_simplices);
+  }
+
+  /** \brief Returns whether the cocycle created by the simplex of key key is still alive, in at least one field.*/
+  bool has_cocycle(SimplexKey key) const {
+    return transverse_idx_[key].row_ != nullptr;
+  }
+
+  /** \brief Returns the product of the characteristics of the fields in which the cocycle created by the simplex of
+   * key key is alive.*/
+  Arith_element characteristics(SimplexKey key) const {
+    return transverse_idx_[key].characteristics_;
+  }
+
+ private:
+  /* Columns that may contain the key of the row. */
+  struct Row {
+    Row()
+        : columns_(),
+          compacted_size_(0) {
+    }
+
+    std::vector<Column*> columns_;
+    // Size of columns_ after its last compaction.
+    std::size_t compacted_size_;
+  };
+
+  /*
+   * Structure representing a cocycle.
+   */
+  struct cocycle {
+    cocycle()
+        : row_(nullptr),
+          characteristics_() {
+    }
+    cocycle(Arith_element characteristics, Row * row)
+        : row_(row),
+          characteristics_(characteristics) {
+    }
+
+    Row * row_;                      // points to the corresponding row
+    Arith_element characteristics_;  // product of field characteristics for which the cocycle exist
+  };
+
+  /* Lexicographic order on the columns, to detect identical columns. */
+  struct Column_order {
+    explicit Column_order(const Contiguous_annotation_matrix* matrix)
+        : matrix_(matrix) {
+    }
+    bool operator()(const Column& c1, const Column& c2) const {
+      const Cell* cells = matrix_->cells_.data();
+      return std::lexicographical_compare(cells + c1.begin_, cells + c1.begin_ + c1.size_,
+                                          cells + c2.begin_, cells + c2.begin_ + c2.size_);
+    }
+    const Contiguous_annotation_matrix* matrix_;
+  };
+
+  static SimplexKey key_of(const std::pair<SimplexKey, Arith_element>& cell) {
+    return cell.first;
+  }
+  static SimplexKey key_of(SimplexKey cell) {
+    return cell;
+  }
+  static Arith_element coefficient_of(const std::pair<SimplexKey, Arith_element>& cell) {
+    return cell.second;
+  }
+  static Arith_element coefficient_of(SimplexKey) {
+    return 1;
+  }
+  static Cell make_cell(SimplexKey key, Arith_element x) {
+    return make_cell(key, x, std::integral_constant<bool, unit_coefficients>());
+  }
+  static Cell make_cell(SimplexKey key, Arith_element, std::true_type) {
+    return key;
+  }
+  static Cell make_cell(SimplexKey key, Arith_element x, std::false_type) {
+    return Cell(key, x);
+  }
+
+  /* Returns the cell of key key in col, or nullptr if col does not contain key or is dead. */
+  const Cell* find_cell(const Column& col, SimplexKey key) const {
+    if (!col.alive_)
+      return nullptr;
+    const Cell* first = cells_.data() + col.begin_;
+    const Cell* last = first + col.size_;
+    const Cell* cell = std::lower_bound(first, last, key, [](const Cell& c, SimplexKey k) { return key_of(c) < k; });
+    return (cell != last && key_of(*cell) == key) ? cell : nullptr;
+  }
+
+  /*
+   * Assign:    target <- target + w * other.
+   */
+  void plus_equal_column(Column & target, A_ds_type const& other, Arith_element w, CoefficientField& coeff_field) {
+    merged_.clear();
+    new_keys_.clear();
+    const Cell* target_it = cells_.data() + target.begin_;
+    const Cell* target_end = target_it + target.size_;
+    auto other_it = other.begin();
+    while (target_it != target_end && other_it != other.end()) {
+      if (key_of(*target_it) < other_it->first) {
+        merged_.push_back(*target_it);
+        ++target_it;
+      } else if (key_of(*target_it) > other_it->first) {
+        merged_.push_back(make_cell(other_it->first,
+                                    coeff_field.plus_times_equal(coeff_field.additive_identity(), other_it->second, w)));
+        new_keys_.push_back(other_it->first);
+        ++other_it;
+      } else {
+        Arith_element coefficient = coeff_field.plus_times_equal(coefficient_of(*target_it), other_it->second, w);
+        if (coefficient != coeff_field.additive_identity())
+          merged_.push_back(make_cell(other_it->first, coefficient));
+        ++target_it;
+        ++other_it;
+      }
+    }
+    merged_.insert(merged_.end(), target_it, target_end);
+    for (; other_it != other.end(); ++other_it) {
+      merged_.push_back(make_cell(other_it->first,
+                                  coeff_field.plus_times_equal(coeff_field.additive_identity(), other_it->second, w)));
+      new_keys_.push_back(other_it->first);
+    }
+
+    // Write the merged column back, at the end of the buffer if it does not fit in place.
+    if (merged_.size() > target.capacity_) {
+      unused_cells_ += target.capacity_;
+      target.begin_ = cells_.size();
+      target.capacity_ = merged_.size() + merged_.size() / 2;
+      cells_.resize(cells_.size() + target.capacity_);
+    }
+    std::copy(merged_.begin(), merged_.end(), cells_.begin() + target.begin_);
+    target.size_ = merged_.size();
+
+    for (SimplexKey key : new_keys_)
+      add_to_row(*transverse_idx_[key].row_, key, &target);
+  }
+
+  /* Adds col to row, and removes the columns that do not contain the key of the row any more when the row has
+   * doubled since its last compaction. */
+  void add_to_row(Row& row, SimplexKey key, Column* col) {
+    row.columns_.push_back(col);
+    if (row.columns_.size() >= 8 && row.columns_.size() >= 2 * row.compacted_size_) {
+      std::sort(row.columns_.begin(), row.columns_.end());
+      row.columns_.erase(std::unique(row.columns_.begin(), row.columns_.end()), row.columns_.end());
+      row.columns_.erase(std::remove_if(row.columns_.begin(), row.columns_.end(),
+                                        [&](Column* c) { return find_cell(*c, key) == nullptr; }),
+                         row.columns_.end());
+      row.compacted_size_ = row.columns_.size();
+    }
+  }
+
+  void destroy_column(Column& col) {
+    col.alive_ = false;
+    unused_cells_ += col.capacity_;
+    col.size_ = 0;
+    col.capacity_ = 0;
+    free_columns_.push_back(&col);
+  }
+
+  /* Moves the columns to a new buffer, without gaps, when more than half of the buffer is unused. The traversal of
+   * all the columns, alive or not, is paid by the unused cells. */
+  void compact_if_needed() {
+    if (unused_cells_ < 1024 || 2 * unused_cells_ < cells_.size() || unused_cells_ < columns_.size())
+      return;
+    std::vector<Cell> new_cells;
+    new_cells.reserve(cells_.size() - unused_cells_);
+    for (Column& col : columns_) {
+      if (!col.alive_)
+        continue;
+      std::size_t begin = new_cells.size();
+      new_cells.insert(new_cells.end(), cells_.begin() + col.begin_, cells_.begin() + col.begin_ + col.capacity_);
+      col.begin_ = begin;
+    }
+    cells_.swap(new_cells);
+    unused_cells_ = 0;
+  }
+
+  /* Buffer of the cells of all the columns. */
+  std::vector<Cell> cells_;
+  /* Number of cells of cells_ that are not in the range of a column. */
+  std::size_t unused_cells_;
+  /* The columns, never moved in memory. The destroyed columns are kept, marked as not alive, because they may still
+   * appear in rows, and reused by the next cocycles: a row may contain columns without its key anyway. */
+  std::deque<Column> columns_;
+  /* The destroyed columns of columns_, to be reused. */
+  std::vector<Column*> free_columns_;
+  /* The columns, ordered lexicographically. */
+  boost::intrusive::set<Column, boost::intrusive::compare<Column_order>,
+                        boost::intrusive::constant_time_size<false> > cam_;
+  /*  Key -> row. The row_ is nullptr if there is no cocycle for the key. */
+  std::vector<cocycle> transverse_idx_;
+  /*  One more than the biggest key of a created cocycle. */
+  std::size_t next_key_;
+  Simple_object_pool<Row> row_pool_;
+  /* Buffers for plus_equal_column. */
+  std::vector<Cell> merged_;
+  std::vector<SimplexKey> new_keys_;
+};
+
+template<typename SimplexKey, typename CoefficientField>
+constexpr bool Contiguous_annotation_matrix<SimplexKey, CoefficientField>::unit_coefficients;
+
+}  // namespace persistent_cohomology
+
+}  // namespace Gudhi
+
+#endif  // PERSISTENT_COHOMOLOGY_CONTIGUOUS_ANNOTATION_MATRIX_H_
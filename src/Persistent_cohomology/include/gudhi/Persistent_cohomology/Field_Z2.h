@@ -0,0 +1,108 @@
+/*    This file is part of the Gudhi Library. The Gudhi library
+ *    (Geometric Understanding in Higher Dimensions) is a generic C++
+ *    library for computational topology.
+ *
+ *    Author(s):       Gudhi contributors
+ *
+ *    Copyright (C) 2018 Inria
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PERSISTENT_COHOMOLOGY_FIELD_Z2_H_
+#define PERSISTENT_COHOMOLOGY_FIELD_Z2_H_
+
+#include <stdexcept>  // for std::invalid_argument
+#include <utility>
+#include <type_traits>
+
+namespace Gudhi {
+
+namespace persistent_cohomology {
+
+/** \brief Structure representing the coefficient field \f$\mathbb{Z}/2\mathbb{Z}\f$
+ *
+ * The elements are 0 and 1, the addition is a xor and the multiplication an and. As the only non-zero coefficient
+ * is 1, `Persistent_cohomology` does not store the coefficients of its annotation matrix with this field.
+ *
+ * \implements CoefficientField
+ * \ingroup persistent_cohomology
+ */
+class Field_Z2 {
+ public:
+  typedef int Element;
+
+  Field_Z2() {}
+
+  /** \brief Does nothing, the characteristic is always 2.
+   *
+   * @exception std::invalid_argument If charac is not 2.
+   */
+  void init(int charac = 2) {
+    if (charac != 2)
+      throw std::invalid_argument("Field_Z2 characteristic must be 2.");
+  }
+
+  /** Set x <- x + w * y*/
+  Element plus_times_equal(const Element& x, const Element& y, const Element& w) const {
+    return x ^ (y & w & 1);
+  }
+
+  /** Returns y * w. w can be any integer, e.g. a multiplicity.*/
+  Element times(const Element& y, const Element& w) const {
+    return y & w & 1;
+  }
+
+  Element plus_equal(const Element& x, const Element& y) const {
+    return x ^ y;
+  }
+
+  /** \brief Returns the additive idendity \f$0_{\Bbbk}\f$ of the field.*/
+  Element additive_identity() const {
+    return 0;
+  }
+  /** \brief Returns the multiplicative identity \f$1_{\Bbbk}\f$ of the field.*/
+  Element multiplicative_identity(Element = 0) const {
+    return 1;
+  }
+  /** Returns the inverse of x, i.e. x itself, and P.*/
+  std::pair<Element, Element> inverse(Element x, Element P) const {
+    return std::pair<Element, Element>(x, P);
+  }
+
+  /** Returns -x * y.*/
+  Element times_minus(Element x, Element y) const {
+    return x & y;
+  }
+
+  /** \brief Returns the characteristic \f$p = 2\f$ of the field.*/
+  int characteristic() const {
+    return 2;
+  }
+};
+
+/** \internal
+ * \brief Whether the only non-zero element of the coefficient field is 1, so that the coefficients of the non-zero
+ * cells of a matrix need not be stored.*/
+template<class CoefficientField>
+struct Has_unit_coefficients : std::false_type {};
+
+template<>
+struct Has_unit_coefficients<Field_Z2> : std::true_type {};
+
+}  // namespace persistent_cohomology
+
+}  // namespace Gudhi
+
+#endif  // PERSISTENT_COHOMOLOGY_FIELD_Z2_H_
@@ -23,6 +23,9 @@
 #ifndef PERSISTENT_COHOMOLOGY_FIELD_ZP_H_
 #define PERSISTENT_COHOMOLOGY_FIELD_ZP_H_
 
+#include <cstdint>
+#include <cassert>
+#include <stdexcept>  // for std::invalid_argument
 #include <utility>
 #include <vector>
 
@@ -31,6 +34,10 @@ namespace Gudhi {
 namespace persistent_cohomology {
 
 /** \brief Structure representing the coefficient field \f$\mathbb{Z}/p\mathbb{Z}\f$
+ *
+ * The inverses are precomputed in \f$O(p)\f$ by `init`, and the products are reduced modulo \f$p\f$ with a Barrett
+ * reduction, without division nor branch. The characteristic must be a prime smaller than \f$2^{16}\f$. For
+ * \f$p = 2\f$, `Field_Z2` is faster.
  *
  * \implements CoefficientField
  * \ingroup persistent_cohomology
@@ -41,40 +48,44 @@ class Field_Zp {
 
   Field_Zp()
       : Prime(0),
+        barrett_multiplier_(0),
         inverse_() {
   }
 
+  /** \brief Sets the characteristic \f$p\f$ of the field and precomputes the inverses.
+   *
+   * @exception std::invalid_argument If charac is not in \f$[1, 2^{16}[\f$, as x + w * y must fit in 32 bits for
+   * the Barrett reduction.
+   */
   void init(int charac) {
-    assert(charac > 0);  // division by zero + non negative values
+    if (charac <= 0 || charac >= (1 << 16))
+      throw std::invalid_argument("Field_Zp characteristic must be positive and smaller than 2^16.");
     Prime = charac;
-    inverse_.clear();
-    inverse_.reserve(charac);
-    inverse_.push_back(0);
-    for (int i = 1; i < Prime; ++i) {
-      int inv = 1;
-      while (((inv * i) % Prime) != 1)
-        ++inv;
-      inverse_.push_back(inv);
-    }
+    barrett_multiplier_ = (std::uint64_t(1) << 32) / static_cast<std::uint64_t>(Prime);
+    // For a prime p, p = (p / i) * i + p % i gives 1/i = -(p / i) * 1/(p % i)
+    inverse_.assign(charac, 0);
+    if (Prime > 1)
+      inverse_[1] = 1;
+    for (int i = 2; i < Prime; ++i)
+      inverse_[i] = Prime - reduce(static_cast<std::uint32_t>(Prime / i) *
+                                   static_cast<std::uint32_t>(inverse_[Prime % i]));
   }
 
-  /** Set x <- x + w * y*/
-  Element plus_times_equal(const Element& x, const Element& y, const Element& w) {
+  /** Set x <- x + w * y. x, y and w must be elements of the field, i.e. in \f$[0, p-1]\f$.*/
+  Element plus_times_equal(const Element& x, const Element& y, const Element& w) const {
     assert(Prime > 0);  // division by zero + non negative values
-    Element result = (x + w * y) % Prime;
-    if (result < 0)
-      result += Prime;
-    return result;
+    return reduce(static_cast<std::uint32_t>(x) + static_cast<std::uint32_t>(w) * static_cast<std::uint32_t>(y));
   }
 
 // operator= defined on Element
 
-  /** Returns y * w */
-  Element times(const Element& y, const Element& w) {
-    return plus_times_equal(0, y, (Element)w);
+  /** Returns y * w. y is an element of the field, and w can be any integer, e.g. a multiplicity.*/
+  Element times(const Element& y, const Element& w) const {
+    Element w_mod = w % Prime;
+    return plus_times_equal(0, y, (w_mod < 0) ? w_mod + Prime : w_mod);
   }
 
-  Element plus_equal(const Element& x, const Element& y) {
+  Element plus_equal(const Element& x, const Element& y) const {
     return plus_times_equal(x, y, (Element)1);
   }
 
@@ -87,15 +98,14 @@ class Field_Zp {
     return 1;
   }
   /** Returns the inverse in the field. Modifies P. ??? */
-  std::pair<Element, Element> inverse(Element x, Element P) {
+  std::pair<Element, Element> inverse(Element x, Element P) const {
     return std::pair<Element, Element>(inverse_[x], P);
   }  // <------ return the product of field characteristic for which x is invertible
 
-  /** Returns -x * y.*/
-  Element times_minus(Element x, Element y) {
+  /** Returns -x * y. x and y must be elements of the field.*/
+  Element times_minus(Element x, Element y) const {
     assert(Prime > 0);  // division by zero + non negative values
-    Element out = (-x * y) % Prime;
-    return (out < 0) ? out + Prime : out;
+    return reduce(static_cast<std::uint32_t>(Prime - x) * static_cast<std::uint32_t>(y));
   }
 
   /** \brief Returns the characteristic \f$p\f$ of the field.*/
@@ -104,7 +114,19 @@ class Field_Zp {
   }
 
  private:
+  /** Returns a modulo Prime. The quotient estimated with barrett_multiplier_ is either exact or one less than the
+   * exact quotient, which is corrected with a mask.*/
+  Element reduce(std::uint32_t a) const {
+    std::uint32_t quotient = static_cast<std::uint32_t>((a * barrett_multiplier_) >> 32);
+    std::uint32_t remainder = a - quotient * static_cast<std::uint32_t>(Prime);
+    std::uint32_t p = static_cast<std::uint32_t>(Prime);
+    remainder -= p & (0u - static_cast<std::uint32_t>(remainder >= p));
+    return static_cast<Element>(remainder);
+  }
+
   int Prime;
+  /** floor(2^32 / Prime), for the Barrett reduction.*/
+  std::uint64_t barrett_multiplier_;
   /** Property map Element -> Element, which associate to an element its inverse in the field.*/
   std::vector<Element> inverse_;
 };
@@ -0,0 +1,283 @@
+/*    This file is part of the Gudhi Library. The Gudhi library
+ *    (Geometric Understanding in Higher Dimensions) is a generic C++
+ *    library for computational topology.
+ *
+ *    Author(s):       Gudhi contributors
+ *
+ *    Copyright (C) 2018 Inria
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PERSISTENT_COHOMOLOGY_LINKED_ANNOTATION_MATRIX_H_
+#define PERSISTENT_COHOMOLOGY_LINKED_ANNOTATION_MATRIX_H_
+
+#include <gudhi/Persistent_cohomology/Persistent_cohomology_column.h>
+#include <gudhi/Persistent_cohomology/Field_Z2.h>  // for Has_unit_coefficients
+#include <gudhi/Simple_object_pool.h>
+
+#include <boost/intrusive/set.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include <vector>
+#include <utility>  // for std::pair
+#include <cstddef>  // for std::size_t
+
+namespace Gudhi {
+
+namespace persistent_cohomology {
+
+/** \brief Compressed annotation matrix whose cells are linked in intrusive lists.
+ *
+ * \ingroup persistent_cohomology
+ *
+ * Each non-zero cell is a node of two doubly linked lists, its column and its row, so that a cell is inserted or
+ * removed in constant time, and the columns are stored in an intrusive set, ordered lexicographically, to detect
+ * identical columns. This is the default annotation matrix of `Persistent_cohomology`, and the only one that supports
+ * multi-field persistence.
+ *
+ * \tparam SimplexKey Type of the keys of the simplices.
+ * \tparam CoefficientField Model of `CoefficientField`.
+ */
+template<typename SimplexKey, typename CoefficientField>
+class Linked_annotation_matrix {
+ public:
+  typedef typename CoefficientField::Element Arith_element;
+  // Over Z/2Z, the cells do not store their coefficient.
+  typedef Persistent_cohomology_column<SimplexKey, Arith_element,
+                                       Has_unit_coefficients<CoefficientField>::value> Column;  // contains 1 set_hook
+  // Cell type
+  typedef typename Column::Cell Cell;   // contains 2 list_hooks
+  // Remark: constant_time_size must be false because base_hook_cam_h has auto_unlink link_mode
+  typedef boost::intrusive::list<Cell,
+      boost::intrusive::constant_time_size<false>,
+      boost::intrusive::base_hook<base_hook_cam_h> > Hcell;
+
+  typedef boost::intrusive::set<Column,
+      boost::intrusive::constant_time_size<false> > Cam;
+  // Sparse column type for the annotation of the boundary of an element.
+  typedef std::vector<std::pair<SimplexKey, Arith_element> > A_ds_type;
+
+  /** \brief Creates an empty matrix, with a row per simplex key in [0, num_simplices).*/
+  explicit Linked_annotation_matrix(std::size_t num_simplices)
+      : cam_(),                            // collection of annotation vectors
+        transverse_idx_(num_simplices),    // key -> row
+        next_key_(0),
+        column_pool_(),                    // memory pools for the CAM
+        cell_pool_() {
+  }
+
+  Linked_annotation_matrix(const Linked_annotation_matrix&) = delete;
+  Linked_annotation_matrix& operator=(const Linked_annotation_matrix&) = delete;
+
+  ~Linked_annotation_matrix() {
+    // Clean the transversal lists
+    for (auto & transverse_ref : transverse_idx_) {
+      if (transverse_ref.row_ != nullptr) {
+        // Destruct all the cells
+        transverse_ref.row_->clear_and_dispose([&](Cell*p){p->~Cell();});
+        delete transverse_ref.row_;
+      }
+    }
+  }
+
+  /** \brief Calls f(key, coefficient) for every non-zero cell of the column, by increasing key.*/
+  template<class Function>
+  static void for_each_cell(const Column& col, Function&& f) {
+    for (auto& cell_ref : col.col_)
+      f(cell_ref.key_, cell_ref.coefficient());
+  }
+
+  /** \brief Creates the cocycle of the simplex of key key, which worths x on this simplex and 0 elsewhere, and
+   * returns its column.*/
+  Column* create_cocycle(SimplexKey key, Arith_element x, Arith_element charac) {
+    // Create a column containing only one cell,
+    Column * new_col = column_pool_.construct(key);
+    Cell * new_cell = cell_pool_.construct(key, x, new_col);
+    new_col->col_.push_back(*new_cell);
+    // and insert it in the matrix. When key is the biggest key used so far,
+    // *new_col has the biggest lexicographic value, and the insertion is in
+    // constant time thanks to the hint cam_.end(). It is not the case for the
+    // delayed cocycles of the smaller keys, created when the dimension grows.
+    if (static_cast<std::size_t>(key) >= next_key_) {
+      cam_.insert(cam_.end(), *new_col);
+      next_key_ = static_cast<std::size_t>(key) + 1;
+    } else {
+      cam_.insert(*new_col);
+    }
+    // Update the disjoint sets data structure.
+    Hcell * new_hcell = new Hcell;
+    new_hcell->push_back(*new_cell);
+    transverse_idx_[key] = cocycle(charac, new_hcell);  // insert the new row
+    return new_col;
+  }
+
+  /** \brief Zeroes out the row of death_key, by adding a multiple of a_ds to every column with a non-zero cell in
+   * this row, for the fields of characteristic charac.
+   *
+   * on_null(col) is called before col is destroyed because it became null, and on_merge(col, other) before col is
+   * destroyed because it became equal to the column other already in the matrix.*/
+  template<class NullColumn, class MergeColumns>
+  void destroy_cocycle(SimplexKey death_key, A_ds_type const& a_ds, Arith_element inv_x, Arith_element charac,
+                       CoefficientField& coeff_field, NullColumn&& on_null, MergeColumns&& on_merge) {
+    cocycle& death_key_row = transverse_idx_[death_key];  // Find the beginning of the row.
+    std::pair<typename Cam::iterator, bool> result_insert_cam;
+
+    auto row_cell_it = death_key_row.row_->begin();
+
+    while (row_cell_it != death_key_row.row_->end()) {  // Traverse all cells in
+      // the row at index death_key.
+      Arith_element w = coeff_field.times_minus(inv_x, row_cell_it->coefficient());
+
+      if (w != coeff_field.additive_identity()) {
+        Column * curr_col = row_cell_it->self_col_;
+        ++row_cell_it;
+        // Disconnect the column from the rows in the CAM.
+        for (auto& col_cell : curr_col->col_) {
+          col_cell.base_hook_cam_h::unlink();
+        }
+
+        // Remove the column from the CAM before modifying its value
+        cam_.erase(cam_.iterator_to(*curr_col));
+        // Proceed to the reduction of the column
+        plus_equal_column(*curr_col, a_ds, w, coeff_field);
+
+        if (curr_col->col_.empty()) {  // If the column is null
+          on_null(*curr_col);
+          column_pool_.destroy(curr_col);  // delete curr_col;
+        } else {
+          // Find whether the column obtained is already in the CAM
+          result_insert_cam = cam_.insert(*curr_col);
+          if (result_insert_cam.second) {  // If it was not in the CAM before: insertion has succeeded
+            for (auto& col_cell : curr_col->col_) {
+              // re-establish the row links
+              transverse_idx_[col_cell.key_].row_->push_front(col_cell);
+            }
+          } else {  // There is already an identical column in the CAM:
+            // merge two disjoint sets.
+            on_merge(*curr_col, *(result_insert_cam.first));
+            // intrusive containers don't own their elements, we have to release them manually
+            curr_col->col_.clear_and_dispose([&](Cell*p){cell_pool_.destroy(p);});
+            column_pool_.destroy(curr_col);  // delete curr_col;
+          }
+        }
+      } else {
+        ++row_cell_it;
+      }  // If w == 0, pass.
+    }
+
+    if (death_key_row.characteristics_ == charac) {
+      delete death_key_row.row_;
+      death_key_row.row_ = nullptr;
+    } else {
+      death_key_row.characteristics_ /= charac;
+    }
+  }
+
+  /** \brief Adds a row without cocycle for every new simplex key in [old number of simplices, num_simplices).*/
+  void resize(std::size_t num_simplices) {
+    transverse_idx_.resize(num_simplices);
+  }
+
+  /** \brief Returns whether the cocycle created by the simplex of key key is still alive, in at least one field.*/
+  bool has_cocycle(SimplexKey key) const {
+    return transverse_idx_[key].row_ != nullptr;
+  }
+
+  /** \brief Returns the product of the characteristics of the fields in which the cocycle created by the simplex of
+   * key key is alive.*/
+  Arith_element characteristics(SimplexKey key) const {
+    return transverse_idx_[key].characteristics_;
+  }
+
+ private:
+  /*
+   * Assign:    target <- target + w * other.
+   */
+  void plus_equal_column(Column & target, A_ds_type const& other  // value_type is pair<Simplex_key,Arith_element>
+                         , Arith_element w, CoefficientField& coeff_field) {
+    auto target_it = target.col_.begin();
+    auto other_it = other.begin();
+    while (target_it != target.col_.end() && other_it != other.end()) {
+      if (target_it->key_ < other_it->first) {
+        ++target_it;
+      } else {
+        if (target_it->key_ > other_it->first) {
+          Cell * cell_tmp = cell_pool_.construct(Cell(other_it->first   // key
+              , coeff_field.plus_times_equal(coeff_field.additive_identity(), other_it->second, w), &target));
+
+          target.col_.insert(target_it, *cell_tmp);
+
+          ++other_it;
+        } else {  // it1->key == it2->key
+          // target_it->coefficient <- target_it->coefficient + other_it->second * w
+          Arith_element coefficient = coeff_field.plus_times_equal(target_it->coefficient(), other_it->second, w);
+          if (coefficient == coeff_field.additive_identity()) {
+            auto tmp_it = target_it;
+            ++target_it;
+            ++other_it;   // iterators remain valid
+            Cell * tmp_cell_ptr = &(*tmp_it);
+            target.col_.erase(tmp_it);  // removed from column
+
+            cell_pool_.destroy(tmp_cell_ptr);  // delete from memory
+          } else {
+            target_it->set_coefficient(coefficient);
+            ++target_it;
+            ++other_it;
+          }
+        }
+      }
+    }
+    while (other_it != other.end()) {
+      Cell * cell_tmp = cell_pool_.construct(Cell(other_it->first
+          , coeff_field.plus_times_equal(coeff_field.additive_identity(), other_it->second, w), &target));
+      target.col_.insert(target.col_.end(), *cell_tmp);
+
+      ++other_it;
+    }
+  }
+
+  /*
+   * Structure representing a cocycle.
+   */
+  struct cocycle {
+    cocycle()
+        : row_(nullptr),
+          characteristics_() {
+    }
+    cocycle(Arith_element characteristics, Hcell * row)
+        : row_(row),
+          characteristics_(characteristics) {
+    }
+
+    Hcell * row_;                    // points to the corresponding row in the CAM
+    Arith_element characteristics_;  // product of field characteristics for which the cocycle exist
+  };
+
+  /* The compressed annotation matrix fields.*/
+  Cam cam_;
+  /*  Key -> row. The row_ is nullptr if there is no cocycle for the key. */
+  std::vector<cocycle> transverse_idx_;
+  /*  One more than the biggest key of a created cocycle. */
+  std::size_t next_key_;
+
+  Simple_object_pool<Column> column_pool_;
+  Simple_object_pool<Cell> cell_pool_;
+};
+
+}  // namespace persistent_cohomology
+
+}  // namespace Gudhi
+
+#endif  // PERSISTENT_COHOMOLOGY_LINKED_ANNOTATION_MATRIX_H_
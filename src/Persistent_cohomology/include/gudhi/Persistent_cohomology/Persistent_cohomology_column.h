@@ -32,7 +32,7 @@ namespace Gudhi {
 
 namespace persistent_cohomology {
 
-template<typename SimplexKey, typename ArithmeticElement>
+template<typename SimplexKey, typename ArithmeticElement, bool UnitCoefficients>
 class Persistent_cohomology_column;
 
 struct cam_h_tag;
@@ -48,28 +48,63 @@ typedef boost::intrusive::list_base_hook<boost::intrusive::tag<cam_v_tag>,
     boost::intrusive::link_mode<boost::intrusive::normal_link>  // faster hook, less safe
 > base_hook_cam_v;
 
+/** \internal
+ * \brief Coefficient of a cell of the Compressed Annotation Matrix.
+ *
+ * Nothing is stored when UnitCoefficients is true, i.e. when 1 is the only non-zero element of the field.
+ */
+template<typename ArithmeticElement, bool UnitCoefficients>
+class Persistent_cohomology_cell_coefficient {
+ public:
+  explicit Persistent_cohomology_cell_coefficient(ArithmeticElement x)
+      : coefficient_(x) {
+  }
+
+  ArithmeticElement coefficient() const {
+    return coefficient_;
+  }
+  void set_coefficient(ArithmeticElement x) {
+    coefficient_ = x;
+  }
+
+ private:
+  ArithmeticElement coefficient_;
+};
+
+template<typename ArithmeticElement>
+class Persistent_cohomology_cell_coefficient<ArithmeticElement, true> {
+ public:
+  explicit Persistent_cohomology_cell_coefficient(ArithmeticElement) {
+  }
+
+  ArithmeticElement coefficient() const {
+    return 1;
+  }
+  void set_coefficient(ArithmeticElement) {
+  }
+};
+
 /** \internal
  * \brief
  *
  */
-template<typename SimplexKey, typename ArithmeticElement>
+template<typename SimplexKey, typename ArithmeticElement, bool UnitCoefficients = false>
 class Persistent_cohomology_cell : public base_hook_cam_h,
-    public base_hook_cam_v {
+    public base_hook_cam_v,
+    public Persistent_cohomology_cell_coefficient<ArithmeticElement, UnitCoefficients> {
  public:
-  template<class T1, class T2> friend class Persistent_cohomology;
-  friend class Persistent_cohomology_column<SimplexKey, ArithmeticElement>;
+  friend class Persistent_cohomology_column<SimplexKey, ArithmeticElement, UnitCoefficients>;
 
-  typedef Persistent_cohomology_column<SimplexKey, ArithmeticElement> Column;
+  typedef Persistent_cohomology_column<SimplexKey, ArithmeticElement, UnitCoefficients> Column;
 
   Persistent_cohomology_cell(SimplexKey key, ArithmeticElement x,
                              Column * self_col)
-      : key_(key),
-        coefficient_(x),
+      : Persistent_cohomology_cell_coefficient<ArithmeticElement, UnitCoefficients>(x),
+        key_(key),
         self_col_(self_col) {
   }
 
   SimplexKey key_;
-  ArithmeticElement coefficient_;
   Column * self_col_;
 };
 
@@ -82,13 +117,12 @@ class Persistent_cohomology_cell : public base_hook_cam_h,
  *
  * Movable but not Copyable.
  */
-template<typename SimplexKey, typename ArithmeticElement>
+template<typename SimplexKey, typename ArithmeticElement, bool UnitCoefficients = false>
 class Persistent_cohomology_column : public boost::intrusive::set_base_hook<
     boost::intrusive::link_mode<boost::intrusive::normal_link> > {
-  template<class T1, class T2> friend class Persistent_cohomology;
 
  public:
-  typedef Persistent_cohomology_cell<SimplexKey, ArithmeticElement> Cell;
+  typedef Persistent_cohomology_cell<SimplexKey, ArithmeticElement, UnitCoefficients> Cell;
   typedef boost::intrusive::list<Cell,
       boost::intrusive::constant_time_size<false>,
       boost::intrusive::base_hook<base_hook_cam_v> > Col_type;
@@ -116,11 +150,11 @@ class Persistent_cohomology_column : public boost::intrusive::set_base_hook<
     typename Col_type::const_iterator it2 = c2.col_.begin();
     while (it1 != c1.col_.end() && it2 != c2.col_.end()) {
       if (it1->key_ == it2->key_) {
-        if (it1->coefficient_ == it2->coefficient_) {
+        if (it1->coefficient() == it2->coefficient()) {
           ++it1;
           ++it2;
         } else {
-          return it1->coefficient_ < it2->coefficient_;
+          return it1->coefficient() < it2->coefficient();
         }
       } else {
         return it1->key_ < it2->key_;
@@ -0,0 +1,156 @@
+/*    This file is part of the Gudhi Library. The Gudhi library
+ *    (Geometric Understanding in Higher Dimensions) is a generic C++
+ *    library for computational topology.
+ *
+ *    Author(s):       Gudhi contributors
+ *
+ *    Copyright (C) 2018 Inria
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PERSISTENT_COHOMOLOGY_PERSISTENT_INTERVALS_H_
+#define PERSISTENT_COHOMOLOGY_PERSISTENT_INTERVALS_H_
+
+#include <vector>
+#include <utility>  // for std::pair
+#include <tuple>  // for std::get
+#include <algorithm>  // for std::sort
+#include <iostream>
+#include <fstream>  // std::ofstream
+#include <limits>  // for numeric_limits<>
+#include <string>
+
+namespace Gudhi {
+
+namespace persistent_cohomology {
+
+namespace internal {
+
+/* Outputs of the persistence intervals shared by Persistent_cohomology and Persistent_homology_matrix_reduction, so
+ * that both engines give the same diagrams and Betti numbers. An interval is a tuple (birth simplex, death simplex,
+ * characteristic), where the death simplex is the null_simplex() of the complex for the infinite intervals, and the
+ * characteristic is the product of the characteristics of the fields in which the interval exists. */
+template<class FilteredComplex, class PersistentInterval>
+struct Persistent_intervals {
+  typedef typename FilteredComplex::Filtration_value Filtration_value;
+
+  static Filtration_value birth(FilteredComplex* cpx, const PersistentInterval& interval) {
+    return cpx->filtration(std::get<0>(interval));
+  }
+  static Filtration_value death(FilteredComplex* cpx, const PersistentInterval& interval) {
+    return cpx->filtration(std::get<1>(interval));
+  }
+  static int dimension(FilteredComplex* cpx, const PersistentInterval& interval) {
+    return static_cast<int>(cpx->dimension(std::get<0>(interval)));
+  }
+  static bool is_infinite(FilteredComplex* cpx, const PersistentInterval& interval) {
+    return std::get<1>(interval) == cpx->null_simplex();
+  }
+  // Whether the interval covers [from, to]. null_simplex test: if the function is called with to=+infinity, we still
+  // get something useful. And it will still work if we change the complex filtration function to reject null
+  // simplices.
+  static bool covers(FilteredComplex* cpx, const PersistentInterval& interval, Filtration_value from,
+                     Filtration_value to) {
+    return birth(cpx, interval) <= from && (is_infinite(cpx, interval) || death(cpx, interval) > to);
+  }
+
+  /* Sorts the intervals by decreasing length, then writes them in the format of output_diagram if
+   * with_characteristic, and of write_output_diagram otherwise. */
+  static void output_diagram(FilteredComplex* cpx, std::vector<PersistentInterval>& intervals,
+                             std::ostream& ostream, bool with_characteristic) {
+    std::sort(std::begin(intervals), std::end(intervals),
+              [cpx](const PersistentInterval& p1, const PersistentInterval& p2) {
+                return death(cpx, p1) - birth(cpx, p1) > death(cpx, p2) - birth(cpx, p2);
+              });
+    bool has_infinity = std::numeric_limits<Filtration_value>::has_infinity;
+    // The trailing spaces of output_diagram are kept for compatibility (cf. unitary tests and R package TDA).
+    const char* end_of_line = with_characteristic ? " " : "";
+    for (auto&& pair : intervals) {
+      if (with_characteristic) ostream << std::get<2>(pair) << "  ";
+      ostream << cpx->dimension(std::get<0>(pair)) << " " << birth(cpx, pair) << " ";
+      // Special case on windows, inf is "1.#INF"
+      if (has_infinity && death(cpx, pair) == std::numeric_limits<Filtration_value>::infinity()) {
+        ostream << "inf" << end_of_line << std::endl;
+      } else {
+        ostream << death(cpx, pair) << end_of_line << std::endl;
+      }
+    }
+  }
+
+  static void write_output_diagram(FilteredComplex* cpx, std::vector<PersistentInterval>& intervals,
+                                   const std::string& diagram_name) {
+    std::ofstream diagram_out(diagram_name.c_str());
+    output_diagram(cpx, intervals, diagram_out, false);
+  }
+
+  static std::vector<int> betti_numbers(FilteredComplex* cpx, const std::vector<PersistentInterval>& intervals,
+                                        int dim_max) {
+    // Init Betti numbers vector with zeros until Simplicial complex dimension
+    std::vector<int> betti_numbers(dim_max, 0);
+    for (auto&& pair : intervals) {
+      // Count never ended persistence intervals
+      if (is_infinite(cpx, pair)) betti_numbers[dimension(cpx, pair)] += 1;
+    }
+    return betti_numbers;
+  }
+
+  static int betti_number(FilteredComplex* cpx, const std::vector<PersistentInterval>& intervals, int dim) {
+    int betti_number = 0;
+    for (auto&& pair : intervals) {
+      // Count never ended persistence intervals
+      if (is_infinite(cpx, pair) && dimension(cpx, pair) == dim) ++betti_number;
+    }
+    return betti_number;
+  }
+
+  static std::vector<int> persistent_betti_numbers(FilteredComplex* cpx,
+                                                   const std::vector<PersistentInterval>& intervals, int dim_max,
+                                                   Filtration_value from, Filtration_value to) {
+    // Init Betti numbers vector with zeros until Simplicial complex dimension
+    std::vector<int> betti_numbers(dim_max, 0);
+    for (auto&& pair : intervals) {
+      // Count persistence intervals that covers the given interval
+      if (covers(cpx, pair, from, to)) betti_numbers[dimension(cpx, pair)] += 1;
+    }
+    return betti_numbers;
+  }
+
+  static int persistent_betti_number(FilteredComplex* cpx, const std::vector<PersistentInterval>& intervals, int dim,
+                                     Filtration_value from, Filtration_value to) {
+    int betti_number = 0;
+    for (auto&& pair : intervals) {
+      // Count persistence intervals that covers the given interval
+      if (covers(cpx, pair, from, to) && dimension(cpx, pair) == dim) ++betti_number;
+    }
+    return betti_number;
+  }
+
+  static std::vector<std::pair<Filtration_value, Filtration_value> >
+  intervals_in_dimension(FilteredComplex* cpx, const std::vector<PersistentInterval>& intervals, int dim) {
+    std::vector<std::pair<Filtration_value, Filtration_value> > result;
+    for (auto&& pair : intervals) {
+      if (dimension(cpx, pair) == dim) result.emplace_back(birth(cpx, pair), death(cpx, pair));
+    }
+    return result;
+  }
+};
+
+}  // namespace internal
+
+}  // namespace persistent_cohomology
+
+}  // namespace Gudhi
+
+#endif  // PERSISTENT_COHOMOLOGY_PERSISTENT_INTERVALS_H_
@@ -0,0 +1,484 @@
+/*    This file is part of the Gudhi Library. The Gudhi library
+ *    (Geometric Understanding in Higher Dimensions) is a generic C++
+ *    library for computational topology.
+ *
+ *    Author(s):       Gudhi contributors
+ *
+ *    Copyright (C) 2018 Inria
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PERSISTENT_HOMOLOGY_MATRIX_REDUCTION_H_
+#define PERSISTENT_HOMOLOGY_MATRIX_REDUCTION_H_
+
+#include <gudhi/Persistent_cohomology/Field_Zp.h>
+#include <gudhi/Persistent_cohomology/Field_Z2.h>
+#include <gudhi/Persistent_cohomology/Persistent_intervals.h>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#endif
+
+#include <vector>
+#include <utility>  // for std::pair, std::swap
+#include <tuple>
+#include <algorithm>  // for std::sort
+#include <iostream>
+#include <limits>  // for numeric_limits<>
+#include <string>
+#include <stdexcept>  // for std::out_of_range
+#include <cstddef>  // for std::size_t
+
+namespace Gudhi {
+
+namespace persistent_cohomology {
+
+/** \brief Computes the persistent homology of a filtered complex by reduction of its boundary matrix.
+ *
+ * \ingroup persistent_cohomology
+ *
+ * This is an alternative to `Persistent_cohomology`, with the same interface and the same persistence diagram.
+ * The columns of the boundary matrix are reduced from the highest dimension to the lowest one, which allows to skip
+ * the columns of the simplices that are known to be positive because they are the pivot of a reduced column of the
+ * next dimension (clearing, or twist optimization) \cite Chen11persistenthomology . The edges are processed with
+ * a union-find data structure, as in `Persistent_cohomology`.
+ *
+ * The reduced columns are stored contiguously, and the memory used only depends on the number of simplices and the
+ * sizes of the reduced columns. Which of this engine and the compressed annotation matrix of `Persistent_cohomology`
+ * is faster depends on the input: the boundary matrix reduction benefits from the clearing in complexes with many
+ * high dimensional simplices that are not essential, but it uses more memory when the reduced columns are dense. The
+ * `performance_rips_persistence` benchmark compares both engines on the same complex.
+ *
+ * When TBB is available, the columns of each dimension are reduced by chunks of consecutive keys in parallel, then the
+ * few columns whose pivot lies in a previous chunk are finished sequentially. Unlike the annotation algorithm of
+ * `Persistent_cohomology`, which is inherently sequential, this engine thus scales with the number of cores. It
+ * requires the complex to provide `boundary_oriented_simplex_range` for concurrent reads.
+ *
+ * \tparam FilteredComplex Model of `FilteredComplex`.
+ * \tparam CoefficientField Model of `CoefficientField` with a single field, e.g. `Field_Zp` or `Field_Z2`. Multi-field
+ * persistence is not supported by this class.
+ *
+ * \implements PersistentHomology
+ */
+template<class FilteredComplex, class CoefficientField = Field_Zp>
+class Persistent_homology_matrix_reduction {
+ public:
+  typedef FilteredComplex Complex_ds;
+  typedef typename Complex_ds::Simplex_key Simplex_key;
+  typedef typename Complex_ds::Simplex_handle Simplex_handle;
+  typedef typename Complex_ds::Filtration_value Filtration_value;
+  typedef typename CoefficientField::Element Arith_element;
+  // Sparse column type, sorted by increasing key.
+  typedef std::vector<std::pair<Simplex_key, Arith_element> > Column;
+  // Persistent interval type. The Arith_element field is the characteristic of the coefficient field.
+  typedef std::tuple<Simplex_handle, Simplex_handle, Arith_element> Persistent_interval;
+
+  /** \brief Initializes the Persistent_homology_matrix_reduction class.
+   *
+   * Assigns to each simplex its index in the filtration as key.
+   *
+   * @param[in] cpx Complex for which the persistent homology is computed.
+   * cpx is a model of FilteredComplex
+   * @exception std::out_of_range In case the number of simplices is more than Simplex_key type numeric limit.
+   */
+  explicit Persistent_homology_matrix_reduction(Complex_ds& cpx)
+      : cpx_(&cpx),
+        dim_max_(cpx.dimension()),
+        coeff_field_(),
+        num_simplices_(cpx_->num_simplices()),
+        keys_by_dimension_((std::max)(static_cast<int>(cpx.dimension()) + 1, 1)),
+        persistent_pairs_() {
+    if (num_simplices_ > static_cast<std::size_t>(std::numeric_limits<Simplex_key>::max())) {
+      // num_simplices must be strictly lower than the limit, because a value is reserved for null_key.
+      throw std::out_of_range("The number of simplices is more than Simplex_key type numeric limit.");
+    }
+    Simplex_key idx_fil = 0;
+    for (auto sh : cpx_->filtration_simplex_range()) {
+      cpx_->assign_key(sh, idx_fil);
+      int dim = cpx_->dimension(sh);
+      if (dim >= static_cast<int>(keys_by_dimension_.size()))
+        keys_by_dimension_.resize(dim + 1);
+      keys_by_dimension_[dim].push_back(idx_fil);
+      ++idx_fil;
+    }
+  }
+
+  /** \brief Initializes the Persistent_homology_matrix_reduction class.
+   *
+   * @param[in] cpx Complex for which the persistent homology is computed.
+   * cpx is a model of FilteredComplex
+   *
+   * @param[in] persistence_dim_max if true, the persistent homology for the maximal dimension in the
+   *                                complex is computed. If false, it is ignored. Default is false.
+   */
+  Persistent_homology_matrix_reduction(Complex_ds& cpx, bool persistence_dim_max)
+      : Persistent_homology_matrix_reduction(cpx) {
+    if (persistence_dim_max) {
+      ++dim_max_;
+    }
+  }
+
+  /** \brief Initializes the coefficient field.*/
+  void init_coefficients(int charac) {
+    coeff_field_.init(charac);
+  }
+
+  /** \brief Compute the persistent homology of the filtered simplicial complex.
+   *
+   * The name is the one of `Persistent_cohomology::compute_persistent_cohomology`, so that both classes can be
+   * used interchangeably, the persistence diagrams of homology and cohomology being the same.
+   *
+   * @param[in] min_interval_length the computation discards all intervals of length
+   *                                less or equal than min_interval_length
+   *
+   * Assumes that the filtration provided by the simplicial complex is
+   * valid. Undefined behavior otherwise. */
+  void compute_persistent_cohomology(Filtration_value min_interval_length = 0) {
+    min_interval_length_ = min_interval_length;
+    persistent_pairs_.clear();
+    // Simplices which are the pivot of a reduced column, i.e. which create a class that dies.
+    std::vector<bool> paired(num_simplices_, false);
+    reduce_columns(paired);
+    reduce_edges(paired);
+  }
+
+ private:
+  /* Reduces the columns of dimension at least 2, from the highest dimension to the lowest one.*/
+  void reduce_columns(std::vector<bool>& paired) {
+    // pivot_column[key] is the index in the reduced columns of the current dimension of the one with pivot key, if any.
+    std::vector<std::size_t> pivot_column(num_simplices_, no_column);
+    for (int dim = static_cast<int>(keys_by_dimension_.size()) - 1; dim >= 2; --dim)
+      reduce_columns_in_chunks(dim, paired, pivot_column);
+  }
+
+  /* Reduces the columns of dimension dim, in two phases.
+   *
+   * The columns are split into chunks of consecutive keys. In the first phase, each chunk reduces its columns with its
+   * own columns only, as long as their pivot is not smaller than the first key of the chunk. A column with such a
+   * pivot cannot be reduced by a column of a previous chunk, whose entries are all smaller, so its pivot is final.
+   * The chunks are independent, and are reduced in parallel if TBB is available: each one only writes the columns it
+   * owns and the pivots in its key range.
+   * In the second phase, the columns whose pivot went below their chunk are reduced in filtration order, with all the
+   * reduced columns.*/
+  void reduce_columns_in_chunks(int dim, std::vector<bool>& paired, std::vector<std::size_t>& pivot_column) {
+    // Clearing: the column of a simplex that is the pivot of a column of dimension dim + 1 would reduce to zero
+    std::vector<Simplex_key> keys;
+    for (Simplex_key key : keys_by_dimension_[dim])
+      if (!paired[key])
+        keys.push_back(key);
+
+#ifdef GUDHI_USE_TBB
+    // A few chunks per thread, for the load balancing by work stealing, but not too small ones.
+    const std::size_t min_chunk_size = 1024;
+    std::size_t num_chunks = (std::min)(keys.size() / min_chunk_size + 1,
+                                        static_cast<std::size_t>(4 * tbb::this_task_arena::max_concurrency()));
+#else
+    std::size_t num_chunks = 1;
+#endif
+    // The reduced columns are stored contiguously, in one buffer per chunk and one for the second phase.
+    std::vector<Column> buffers(num_chunks + 1);
+    std::vector<Column_location> columns(keys.size());
+    // Whether the pivot of a column was found in the first phase
+    std::vector<char> local_pivot(keys.size(), false);
+
+    auto reduce_chunk = [&](std::size_t chunk) {
+      std::size_t chunk_begin = chunk * keys.size() / num_chunks;
+      std::size_t chunk_end = (chunk + 1) * keys.size() / num_chunks;
+      if (chunk_begin == chunk_end)
+        return;
+      // There is no previous chunk for the first one, which is thus entirely reduced in the first phase
+      Simplex_key lowest_local_key = (chunk == 0) ? 0 : keys[chunk_begin];
+      Column column, tmp;
+      for (std::size_t i = chunk_begin; i < chunk_end; ++i) {
+        boundary_column(cpx_->simplex(keys[i]), column);
+        while (!column.empty() && column.back().first >= lowest_local_key) {
+          std::size_t other = pivot_column[column.back().first];
+          if (other == no_column) {
+            pivot_column[column.back().first] = i;
+            local_pivot[i] = true;
+            break;
+          }
+          reduce_pivot(column, buffers, columns[other], tmp);
+        }
+        columns[i] = store_column(column, buffers, chunk);
+      }
+    };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), num_chunks, reduce_chunk);
+#else
+    for (std::size_t chunk = 0; chunk < num_chunks; ++chunk)
+      reduce_chunk(chunk);
+#endif
+
+    Column column, tmp;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      if (!local_pivot[i] && columns[i].begin != columns[i].end &&
+          pivot_column[buffers[columns[i].buffer][columns[i].end - 1].first] == no_column) {
+        pivot_column[buffers[columns[i].buffer][columns[i].end - 1].first] = i;
+      } else if (!local_pivot[i] && columns[i].begin != columns[i].end) {
+        column.assign(buffers[columns[i].buffer].begin() + columns[i].begin,
+                      buffers[columns[i].buffer].begin() + columns[i].end);
+        while (!column.empty()) {
+          std::size_t other = pivot_column[column.back().first];
+          if (other == no_column) {
+            pivot_column[column.back().first] = i;
+            break;
+          }
+          reduce_pivot(column, buffers, columns[other], tmp);
+        }
+        columns[i] = store_column(column, buffers, num_chunks);
+      }
+      if (columns[i].begin == columns[i].end) {
+        if (dim < dim_max_)  // Essential class, as the columns of higher dimension are already reduced
+          essential_candidates_.push_back(keys[i]);
+      } else {
+        Simplex_key pivot = buffers[columns[i].buffer][columns[i].end - 1].first;
+        paired[pivot] = true;
+        add_pair(cpx_->simplex(pivot), cpx_->simplex(keys[i]));
+      }
+    }
+    // The reduced columns of dimension dim are not used to reduce the ones of dimension dim - 1
+    for (const Column_location& location : columns)
+      if (location.begin != location.end)
+        pivot_column[buffers[location.buffer][location.end - 1].first] = no_column;
+  }
+
+  /* Position of a reduced column in the buffers.*/
+  struct Column_location {
+    std::size_t buffer;
+    std::size_t begin;
+    std::size_t end;
+  };
+
+  static Column_location store_column(const Column& column, std::vector<Column>& buffers, std::size_t buffer) {
+    Column_location location{buffer, buffers[buffer].size(), buffers[buffer].size() + column.size()};
+    buffers[buffer].insert(buffers[buffer].end(), column.begin(), column.end());
+    return location;
+  }
+
+  /* column <- column + w * other, where w cancels the common pivot of column and other.*/
+  void reduce_pivot(Column& column, const std::vector<Column>& buffers, const Column_location& other, Column& tmp) {
+    const std::pair<Simplex_key, Arith_element>* other_begin = buffers[other.buffer].data() + other.begin;
+    const std::pair<Simplex_key, Arith_element>* other_end = buffers[other.buffer].data() + other.end;
+    Arith_element inv = coeff_field_.inverse((other_end - 1)->second, coeff_field_.characteristic()).first;
+    Arith_element w = coeff_field_.times_minus(inv, column.back().second);
+    plus_equal_column(column, other_begin, other_end, w, tmp);
+  }
+
+  /* Computes the pairs of edges with vertices, with a union-find data structure where the root of a connected
+   * component is its oldest vertex.*/
+  void reduce_edges(std::vector<bool>& paired) {
+    std::vector<Simplex_key> parent(num_simplices_);
+    for (std::size_t idx = 0; idx < num_simplices_; ++idx)
+      parent[idx] = idx;
+    auto find_root = [&](Simplex_key key) {
+      while (parent[key] != key) {
+        parent[key] = parent[parent[key]];  // path halving
+        key = parent[key];
+      }
+      return key;
+    };
+
+    if (keys_by_dimension_.size() > 1) {
+      for (Simplex_key key : keys_by_dimension_[1]) {
+        if (paired[key])
+          continue;
+        Simplex_handle sigma = cpx_->simplex(key);
+        Simplex_handle u, v;
+        std::tie(u, v) = cpx_->endpoints(sigma);
+        Simplex_key ru = find_root(cpx_->key(u));
+        Simplex_key rv = find_root(cpx_->key(v));
+        if (ru == rv) {  // sigma creates a 1-cycle, which never dies
+          if (dim_max_ > 1)
+            essential_candidates_.push_back(key);
+        } else {  // Kill the younger connected component
+          if (ru < rv)
+            std::swap(ru, rv);
+          paired[ru] = true;
+          parent[ru] = rv;
+          add_pair(cpx_->simplex(ru), sigma);
+        }
+      }
+    }
+
+    for (Simplex_key key : keys_by_dimension_[0]) {
+      if (!paired[key])
+        persistent_pairs_.emplace_back(cpx_->simplex(key), cpx_->null_simplex(), coeff_field_.characteristic());
+    }
+    for (Simplex_key key : essential_candidates_) {
+      if (!paired[key])
+        persistent_pairs_.emplace_back(cpx_->simplex(key), cpx_->null_simplex(), coeff_field_.characteristic());
+    }
+    essential_candidates_.clear();
+  }
+
+  /* Records the interval [birth, death) if it is long enough.*/
+  void add_pair(Simplex_handle birth, Simplex_handle death) {
+    if (cpx_->filtration(death) - cpx_->filtration(birth) > min_interval_length_)
+      persistent_pairs_.emplace_back(birth, death, coeff_field_.characteristic());
+  }
+
+  /* Fills column with the boundary of sigma, sorted by key.*/
+  void boundary_column(Simplex_handle sigma, Column& column) {
+    column.clear();
+    for (auto osh : cpx_->boundary_oriented_simplex_range(sigma)) {
+      Arith_element coef = coeff_field_.times(coeff_field_.multiplicative_identity(), osh.second);
+      if (coef != coeff_field_.additive_identity())
+        column.emplace_back(cpx_->key(osh.first), coef);
+    }
+    std::sort(column.begin(), column.end(),
+              [](std::pair<Simplex_key, Arith_element> const& a, std::pair<Simplex_key, Arith_element> const& b) {
+                return a.first < b.first;
+              });
+    // A face may appear several times in the boundary of a cell, e.g. in a periodic cubical complex
+    auto last = column.begin();
+    for (auto it = column.begin(); it != column.end(); ++it) {
+      if (last != column.begin() && (last - 1)->first == it->first) {
+        (last - 1)->second = coeff_field_.plus_equal((last - 1)->second, it->second);
+        if ((last - 1)->second == coeff_field_.additive_identity())
+          --last;
+      } else {
+        *last++ = *it;
+      }
+    }
+    column.erase(last, column.end());
+  }
+
+  /* Assign: target <- target + w * [other_begin, other_end), using tmp as buffer.*/
+  template<typename Iterator>
+  void plus_equal_column(Column& target, Iterator other_begin, Iterator other_end, Arith_element w, Column& tmp) {
+    tmp.clear();
+    auto target_it = target.begin();
+    while (target_it != target.end() && other_begin != other_end) {
+      if (target_it->first < other_begin->first) {
+        tmp.push_back(*target_it);
+        ++target_it;
+      } else if (other_begin->first < target_it->first) {
+        tmp.emplace_back(other_begin->first, coeff_field_.times(other_begin->second, w));
+        ++other_begin;
+      } else {
+        Arith_element coef = coeff_field_.plus_times_equal(target_it->second, other_begin->second, w);
+        if (coef != coeff_field_.additive_identity())
+          tmp.emplace_back(target_it->first, coef);
+        ++target_it;
+        ++other_begin;
+      }
+    }
+    tmp.insert(tmp.end(), target_it, target.end());
+    for (; other_begin != other_end; ++other_begin)
+      tmp.emplace_back(other_begin->first, coeff_field_.times(other_begin->second, w));
+    target.swap(tmp);
+  }
+
+ public:
+  /** \brief Output the persistence diagram in ostream.
+   *
+   * The file format is the following:
+   *    p   dim b d
+   *
+   * where "dim" is the dimension of the homological feature,
+   * b and d are respectively the birth and death of the feature and
+   * p is the characteristic of the field Z/pZ used for homology coefficients.
+   */
+  void output_diagram(std::ostream& ostream = std::cout) {
+    Intervals::output_diagram(cpx_, persistent_pairs_, ostream, true);
+  }
+
+  /** \brief Writes the persistence diagram in the file diagram_name, in the format of output_diagram without the
+   * characteristic of the fields. */
+  void write_output_diagram(std::string diagram_name) {
+    Intervals::write_output_diagram(cpx_, persistent_pairs_, diagram_name);
+  }
+
+  /** @brief Returns Betti numbers.
+   * @return A vector of Betti numbers.
+   */
+  std::vector<int> betti_numbers() const {
+    return Intervals::betti_numbers(cpx_, persistent_pairs_, dim_max_);
+  }
+
+  /** @brief Returns the Betti number of the dimension passed by parameter.
+   * @param[in] dimension The Betti number dimension to get.
+   * @return Betti number of the given dimension
+   *
+   */
+  int betti_number(int dimension) const {
+    return Intervals::betti_number(cpx_, persistent_pairs_, dimension);
+  }
+
+  /** @brief Returns the persistent Betti numbers.
+   * @param[in] from The persistence birth limit to be added in the number \f$(persistent birth \leq from)\f$.
+   * @param[in] to The persistence death limit to be added in the number  \f$(persistent death > to)\f$.
+   * @return A vector of persistent Betti numbers.
+   */
+  std::vector<int> persistent_betti_numbers(Filtration_value from, Filtration_value to) const {
+    return Intervals::persistent_betti_numbers(cpx_, persistent_pairs_, dim_max_, from, to);
+  }
+
+  /** @brief Returns the persistent Betti number of the dimension passed by parameter.
+   * @param[in] dimension The Betti number dimension to get.
+   * @param[in] from The persistence birth limit to be added in the number \f$(persistent birth \leq from)\f$.
+   * @param[in] to The persistence death limit to be added in the number  \f$(persistent death > to)\f$.
+   * @return Persistent Betti number of the given dimension
+   */
+  int persistent_betti_number(int dimension, Filtration_value from, Filtration_value to) const {
+    return Intervals::persistent_betti_number(cpx_, persistent_pairs_, dimension, from, to);
+  }
+
+  /** @brief Returns the persistent pairs.
+   * @return Persistent pairs
+   *
+   */
+  const std::vector<Persistent_interval>& get_persistent_pairs() const {
+    return persistent_pairs_;
+  }
+
+  /** @brief Returns persistence intervals for a given dimension.
+   * @param[in] dimension Dimension to get the birth and death pairs from.
+   * @return A vector of persistence intervals (birth and death) on a fixed dimension.
+   */
+  std::vector< std::pair< Filtration_value , Filtration_value > >
+  intervals_in_dimension(int dimension) {
+    return Intervals::intervals_in_dimension(cpx_, persistent_pairs_, dimension);
+  }
+
+ private:
+  // Outputs of the intervals, shared with Persistent_cohomology.
+  typedef internal::Persistent_intervals<Complex_ds, Persistent_interval> Intervals;
+
+  static constexpr std::size_t no_column = std::numeric_limits<std::size_t>::max();
+
+  Complex_ds * cpx_;
+  int dim_max_;
+  CoefficientField coeff_field_;
+  std::size_t num_simplices_;
+  /* Keys of the simplices of each dimension, in the order of the filtration.*/
+  std::vector<std::vector<Simplex_key> > keys_by_dimension_;
+  /* Keys of the simplices with a zero reduced column, which are essential unless they get paired later.*/
+  std::vector<Simplex_key> essential_candidates_;
+  Filtration_value min_interval_length_;
+  /* Persistent intervals. */
+  std::vector<Persistent_interval> persistent_pairs_;
+};
+
+template<class FilteredComplex, class CoefficientField>
+constexpr std::size_t Persistent_homology_matrix_reduction<FilteredComplex, CoefficientField>::no_column;
+
+}  // namespace persistent_cohomology
+
+}  // namespace Gudhi
+
+#endif  // PERSISTENT_HOMOLOGY_MATRIX_REDUCTION_H_
@@ -5,6 +5,8 @@
 #include <cmath> // float comparison
 #include <limits>
 #include <cstdint>  // for std::uint8_t
+#include <random>
+#include <numeric>  // for std::iota
 
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE "persistent_cohomology"
@@ -14,6 +16,8 @@
 #include <gudhi/reader_utils.h>
 #include <gudhi/Simplex_tree.h>
 #include <gudhi/Persistent_cohomology.h>
+#include <gudhi/Rips_complex.h>
+#include <gudhi/distance_functions.h>
 
 using namespace Gudhi;
 using namespace Gudhi::persistent_cohomology;
@@ -210,3 +214,253 @@ BOOST_AUTO_TEST_CASE( persistence_constructor_exception )
   BOOST_CHECK_THROW(Mini_st_persistence pcoh2(st), std::out_of_range);
 
 }
+
+BOOST_AUTO_TEST_CASE( field_zp_arithmetic )
+{
+  for (int p : {2, 3, 5, 11, 257, 65521}) {
+    Field_Zp field;
+    field.init(p);
+    BOOST_CHECK(field.characteristic() == p);
+    // Step through the elements, all of them for the small primes
+    int step = (p < 300) ? 1 : 97;
+    for (int x = 0; x < p; x += step) {
+      if (x != 0)
+        BOOST_CHECK((static_cast<long long>(x) * field.inverse(x, p).first) % p == 1);
+      for (int y = 0; y < p; y += step) {
+        BOOST_CHECK(field.plus_equal(x, y) == (x + y) % p);
+        BOOST_CHECK(field.times_minus(x, y) == (p - (static_cast<long long>(x) * y) % p) % p);
+        for (int w = 0; w < p; w += 7 * step)
+          BOOST_CHECK(field.plus_times_equal(x, y, w) == (x + static_cast<long long>(w) * y) % p);
+      }
+      // Multiplicities can be any integer
+      for (int mult : {-3, -1, 1, 4})
+        BOOST_CHECK(field.times(x, mult) == ((static_cast<long long>(x) * mult) % p + p) % p);
+    }
+  }
+  // The Barrett reduction only supports characteristics smaller than 2^16
+  Field_Zp field;
+  BOOST_CHECK_THROW(field.init(0), std::invalid_argument);
+  BOOST_CHECK_THROW(field.init(65537), std::invalid_argument);
+  Field_Z2 field_z2;
+  BOOST_CHECK_THROW(field_z2.init(3), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( field_z2_persistence )
+{
+  std::ifstream simplex_tree_stream;
+  simplex_tree_stream.open("simplex_tree_file_for_unit_test.txt");
+  typeST st;
+  simplex_tree_stream >> st;
+  simplex_tree_stream.close();
+  st.initialize_filtration();
+
+  Persistent_cohomology<Simplex_tree<>, Field_Zp> pcoh_zp(st, true);
+  pcoh_zp.init_coefficients(2);
+  pcoh_zp.compute_persistent_cohomology(0.);
+  std::ostringstream zp_diagram;
+  pcoh_zp.output_diagram(zp_diagram);
+
+  Persistent_cohomology<Simplex_tree<>, Field_Z2> pcoh_z2(st, true);
+  pcoh_z2.init_coefficients(2);
+  pcoh_z2.compute_persistent_cohomology(0.);
+  std::ostringstream z2_diagram;
+  pcoh_z2.output_diagram(z2_diagram);
+
+  BOOST_CHECK(zp_diagram.str() == z2_diagram.str());
+  BOOST_CHECK(pcoh_z2.betti_numbers() == pcoh_zp.betti_numbers());
+}
+
+template<class CoefficientField>
+void compare_annotation_matrices(typeST& st, int coefficient) {
+  Persistent_cohomology<typeST, CoefficientField> pcoh(st, true);
+  pcoh.init_coefficients(coefficient);
+  pcoh.compute_persistent_cohomology(0.);
+
+  Persistent_cohomology<typeST, CoefficientField, Contiguous_annotation_matrix> contiguous_pcoh(st, true);
+  contiguous_pcoh.init_coefficients(coefficient);
+  contiguous_pcoh.compute_persistent_cohomology(0.);
+
+  BOOST_CHECK(pcoh.get_persistent_pairs() == contiguous_pcoh.get_persistent_pairs());
+}
+
+BOOST_AUTO_TEST_CASE( contiguous_annotation_matrix )
+{
+  std::ifstream simplex_tree_stream;
+  simplex_tree_stream.open("simplex_tree_file_for_unit_test.txt");
+  typeST st;
+  simplex_tree_stream >> st;
+  simplex_tree_stream.close();
+  st.initialize_filtration();
+  for (int coefficient : {2, 3, 11})
+    compare_annotation_matrices<Field_Zp>(st, coefficient);
+  compare_annotation_matrices<Field_Z2>(st, 2);
+
+  // Random complex, large enough for the columns to be moved and the cells to be compacted
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> filtration(0., 1.);
+  std::vector<int> vertices(30);
+  std::iota(vertices.begin(), vertices.end(), 0);
+  typeST random_st;
+  for (int i = 0; i < 400; ++i) {
+    // 4 distinct vertices
+    std::shuffle(vertices.begin(), vertices.end(), gen);
+    random_st.insert_simplex_and_subfaces(std::vector<int>(vertices.begin(), vertices.begin() + 4), filtration(gen));
+  }
+  random_st.make_filtration_non_decreasing();
+  random_st.initialize_filtration();
+  std::cout << "Random complex with " << random_st.num_simplices() << " simplices" << std::endl;
+  for (int coefficient : {2, 3})
+    compare_annotation_matrices<Field_Zp>(random_st, coefficient);
+  compare_annotation_matrices<Field_Z2>(random_st, 2);
+}
+
+template<template<class, class> class AnnotationMatrix>
+void compare_incremental_persistence(typeST& st, bool persistence_dim_max, double min_persistence,
+                                     std::vector<double> const& thresholds) {
+  Persistent_cohomology<typeST, Field_Zp, AnnotationMatrix> pcoh(st, persistence_dim_max);
+  pcoh.init_coefficients(3);
+  pcoh.compute_persistent_cohomology(min_persistence);
+
+  // Simplices sorted by filtration value, faces first, inserted by slices of filtration values
+  std::vector<std::pair<double, std::vector<int>>> simplices;
+  for (auto sh : st.complex_simplex_range()) {
+    std::vector<int> simplex;
+    for (auto vertex : st.simplex_vertex_range(sh))
+      simplex.push_back(vertex);
+    simplices.emplace_back(st.filtration(sh), simplex);
+  }
+  std::sort(simplices.begin(), simplices.end(),
+            [](std::pair<double, std::vector<int>> const& s1, std::pair<double, std::vector<int>> const& s2) {
+              return s1.first < s2.first || (s1.first == s2.first && s1.second.size() < s2.second.size());
+            });
+  auto simplex_it = simplices.begin();
+  typeST incremental_st;
+  Persistent_cohomology<typeST, Field_Zp, AnnotationMatrix> incremental_pcoh(incremental_st, persistence_dim_max);
+  incremental_pcoh.init_coefficients(3);
+  incremental_pcoh.compute_persistent_cohomology(min_persistence);
+  for (double threshold : thresholds) {
+    for (; simplex_it != simplices.end() && simplex_it->first <= threshold; ++simplex_it)
+      incremental_st.insert_simplex(simplex_it->second, simplex_it->first);
+    incremental_st.initialize_filtration();
+    incremental_pcoh.update_persistent_cohomology();
+  }
+  BOOST_CHECK(simplex_it == simplices.end());
+  BOOST_CHECK(incremental_st.num_simplices() == st.num_simplices());
+
+  for (int dim = 0; dim <= st.dimension(); ++dim) {
+    auto intervals = pcoh.intervals_in_dimension(dim);
+    auto incremental_intervals = incremental_pcoh.intervals_in_dimension(dim);
+    std::sort(intervals.begin(), intervals.end());
+    std::sort(incremental_intervals.begin(), incremental_intervals.end());
+    BOOST_CHECK(intervals == incremental_intervals);
+  }
+  BOOST_CHECK(pcoh.get_persistent_pairs().size() == incremental_pcoh.get_persistent_pairs().size());
+  BOOST_CHECK(pcoh.betti_numbers() == incremental_pcoh.betti_numbers());
+}
+
+BOOST_AUTO_TEST_CASE( incremental_persistence )
+{
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<double> coordinate(0., 1.);
+  std::vector<std::vector<double>> points(60);
+  for (auto& point : points)
+    point = {coordinate(gen), coordinate(gen), coordinate(gen)};
+  Gudhi::rips_complex::Rips_complex<double> rips(points, 0.5, Gudhi::Euclidean_distance());
+  typeST st;
+  rips.create_complex(st, 3);
+  st.initialize_filtration();
+  std::cout << "Rips complex with " << st.num_simplices() << " simplices" << std::endl;
+
+  // The first slice only contains vertices, then edges, so that the dimension of the complex grows.
+  std::vector<double> thresholds = {0., 0.05, 0.1, 0.2, 0.25, 0.3, 0.4, 0.5};
+  for (bool persistence_dim_max : {false, true}) {
+    compare_incremental_persistence<Linked_annotation_matrix>(st, persistence_dim_max, 0., thresholds);
+    compare_incremental_persistence<Contiguous_annotation_matrix>(st, persistence_dim_max, 0., thresholds);
+  }
+  compare_incremental_persistence<Linked_annotation_matrix>(st, true, 0.05, thresholds);
+  compare_incremental_persistence<Linked_annotation_matrix>(st, false, 0., {0.5});
+
+  // A simplex inserted before the end of the filtration is rejected.
+  Persistent_cohomology<typeST, Field_Zp> pcoh(st);
+  pcoh.init_coefficients(2);
+  pcoh.compute_persistent_cohomology();
+  st.insert_simplex_and_subfaces({100, 101}, 0.1);
+  st.initialize_filtration();
+  BOOST_CHECK_THROW(pcoh.update_persistent_cohomology(), std::invalid_argument);
+
+  // Even when it comes before a killer.
+  typeST killer_st;
+  killer_st.insert_simplex_and_subfaces({0, 1}, 1.);
+  killer_st.assign_filtration(killer_st.find({0}), 0.);
+  killer_st.assign_filtration(killer_st.find({1}), 0.);
+  killer_st.initialize_filtration();
+  Persistent_cohomology<typeST, Field_Zp> killer_pcoh(killer_st);
+  killer_pcoh.init_coefficients(2);
+  killer_pcoh.compute_persistent_cohomology();
+  killer_st.insert_simplex_and_subfaces({2}, 0.5);
+  killer_st.initialize_filtration();
+  BOOST_CHECK_THROW(killer_pcoh.update_persistent_cohomology(), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( persistence_up_to_filtration_and_dimension )
+{
+  std::mt19937 gen(8);
+  std::uniform_real_distribution<double> coordinate(0., 1.);
+  std::vector<std::vector<double>> points(50);
+  for (auto& point : points)
+    point = {coordinate(gen), coordinate(gen), coordinate(gen)};
+  Gudhi::rips_complex::Rips_complex<double> rips(points, 0.6, Gudhi::Euclidean_distance());
+  typeST st;
+  rips.create_complex(st, 4);
+  st.initialize_filtration();
+
+  for (double max_filtration : {0.2, 0.35, 0.6}) {
+    // Subcomplex of the simplices of filtration value at most max_filtration
+    typeST sub_st;
+    for (auto sh : st.filtration_simplex_range()) {
+      if (st.filtration(sh) <= max_filtration) {
+        std::vector<int> simplex;
+        for (auto vertex : st.simplex_vertex_range(sh))
+          simplex.push_back(vertex);
+        sub_st.insert_simplex(simplex, st.filtration(sh));
+      }
+    }
+    sub_st.initialize_filtration();
+    Persistent_cohomology<typeST, Field_Zp> sub_pcoh(sub_st, true);
+    sub_pcoh.init_coefficients(2);
+    sub_pcoh.compute_persistent_cohomology();
+
+    for (int max_dimension : {0, 1, 2}) {
+      Persistent_cohomology<typeST, Field_Zp> pcoh(st, true);
+      pcoh.init_coefficients(2);
+      pcoh.compute_persistent_cohomology_up_to(max_filtration, max_dimension);
+      BOOST_CHECK(pcoh.betti_numbers().size() == static_cast<std::size_t>(max_dimension + 1));
+      std::size_t num_intervals = 0;
+      for (int dim = 0; dim <= max_dimension; ++dim) {
+        auto intervals = pcoh.intervals_in_dimension(dim);
+        auto sub_intervals = sub_pcoh.intervals_in_dimension(dim);
+        std::sort(intervals.begin(), intervals.end());
+        std::sort(sub_intervals.begin(), sub_intervals.end());
+        BOOST_CHECK(intervals == sub_intervals);
+        num_intervals += intervals.size();
+      }
+      BOOST_CHECK(pcoh.get_persistent_pairs().size() == num_intervals);
+    }
+  }
+
+  // The remaining simplices are processed by update_persistent_cohomology()
+  Persistent_cohomology<typeST, Field_Zp> pcoh(st, true);
+  pcoh.init_coefficients(2);
+  pcoh.compute_persistent_cohomology();
+  Persistent_cohomology<typeST, Field_Zp> resumed_pcoh(st, true);
+  resumed_pcoh.init_coefficients(2);
+  resumed_pcoh.compute_persistent_cohomology_up_to(0.3, 10);
+  resumed_pcoh.update_persistent_cohomology();
+  for (int dim = 0; dim <= st.dimension(); ++dim) {
+    auto intervals = pcoh.intervals_in_dimension(dim);
+    auto resumed_intervals = resumed_pcoh.intervals_in_dimension(dim);
+    std::sort(intervals.begin(), intervals.end());
+    std::sort(resumed_intervals.begin(), resumed_intervals.end());
+    BOOST_CHECK(intervals == resumed_intervals);
+  }
+}
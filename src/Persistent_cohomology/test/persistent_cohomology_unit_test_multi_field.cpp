@@ -113,3 +113,22 @@ BOOST_AUTO_TEST_CASE(rips_persistent_cohomology_multi_field_dim_1_5) {
 // TODO(VR): is result OK of :
 // test_rips_persistence_in_dimension(3, 4);
 
+
+BOOST_AUTO_TEST_CASE(contiguous_annotation_matrix_multi_field) {
+  std::ifstream simplex_tree_stream;
+  simplex_tree_stream.open("simplex_tree_file_for_multi_field_unit_test.txt");
+  typeST st;
+  simplex_tree_stream >> st;
+  simplex_tree_stream.close();
+  st.initialize_filtration();
+
+  Persistent_cohomology<Simplex_tree<>, Multi_field> pcoh(st);
+  pcoh.init_coefficients(2, 5);
+  pcoh.compute_persistent_cohomology(0.);
+
+  Persistent_cohomology<Simplex_tree<>, Multi_field, Contiguous_annotation_matrix> contiguous_pcoh(st);
+  contiguous_pcoh.init_coefficients(2, 5);
+  contiguous_pcoh.compute_persistent_cohomology(0.);
+
+  BOOST_CHECK(pcoh.get_persistent_pairs() == contiguous_pcoh.get_persistent_pairs());
+}
@@ -0,0 +1,180 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <algorithm>
+#include <utility>  // std::pair
+#include <vector>
+#include <random>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "persistent_homology_matrix_reduction"
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Hasse_complex.h>
+#include <gudhi/Bitmap_cubical_complex.h>
+#include <gudhi/Rips_complex.h>
+#include <gudhi/distance_functions.h>
+#include <gudhi/Persistent_cohomology.h>
+#include <gudhi/Persistent_homology_matrix_reduction.h>
+
+using namespace Gudhi;
+using namespace Gudhi::persistent_cohomology;
+
+typedef Simplex_tree<> typeST;
+typedef boost::mpl::list<Simplex_tree<>, Simplex_tree<Simplex_tree_options_fast_persistence>> list_of_tested_variants;
+
+/* Checks that Persistent_homology_matrix_reduction and Persistent_cohomology compute the same intervals and Betti
+ * numbers on cpx.*/
+template<class FilteredComplex>
+void compare_with_persistent_cohomology(FilteredComplex& cpx, int coefficient, double min_persistence,
+                                        bool persistence_dim_max) {
+  Persistent_cohomology<FilteredComplex, Field_Zp> pcoh(cpx, persistence_dim_max);
+  pcoh.init_coefficients(coefficient);
+  pcoh.compute_persistent_cohomology(min_persistence);
+
+  Persistent_homology_matrix_reduction<FilteredComplex, Field_Zp> reduction(cpx, persistence_dim_max);
+  reduction.init_coefficients(coefficient);
+  reduction.compute_persistent_cohomology(min_persistence);
+
+  BOOST_CHECK(pcoh.get_persistent_pairs().size() == reduction.get_persistent_pairs().size());
+  for (int dim = 0; dim <= static_cast<int>(cpx.dimension()); ++dim) {
+    auto intervals = pcoh.intervals_in_dimension(dim);
+    auto reduction_intervals = reduction.intervals_in_dimension(dim);
+    std::sort(intervals.begin(), intervals.end());
+    std::sort(reduction_intervals.begin(), reduction_intervals.end());
+    BOOST_CHECK(intervals == reduction_intervals);
+  }
+  BOOST_CHECK(pcoh.betti_numbers() == reduction.betti_numbers());
+  BOOST_CHECK(pcoh.persistent_betti_numbers(0.5, 1.) == reduction.persistent_betti_numbers(0.5, 1.));
+}
+
+BOOST_AUTO_TEST_CASE(matrix_reduction_on_file) {
+  // file is copied in CMakeLists.txt
+  std::ifstream simplex_tree_stream;
+  simplex_tree_stream.open("simplex_tree_file_for_unit_test.txt");
+  typeST st;
+  simplex_tree_stream >> st;
+  simplex_tree_stream.close();
+  BOOST_CHECK(st.num_simplices() == 98);
+  st.initialize_filtration();
+
+  for (int coefficient : {2, 3, 11}) {
+    compare_with_persistent_cohomology(st, coefficient, 0., false);
+    compare_with_persistent_cohomology(st, coefficient, 0., true);
+    compare_with_persistent_cohomology(st, coefficient, 1., false);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(matrix_reduction_on_rips, ST, list_of_tested_variants) {
+  std::mt19937 gen(42);
+  std::normal_distribution<double> coordinate;
+  std::vector<std::vector<double>> points;
+  // Noisy sphere
+  for (int i = 0; i < 60; ++i) {
+    std::vector<double> point = {coordinate(gen), coordinate(gen), coordinate(gen)};
+    double norm = Euclidean_distance()(point, std::vector<double>(3, 0.));
+    for (double& x : point)
+      x = x / norm + coordinate(gen) * 0.05;
+    points.push_back(point);
+  }
+  rips_complex::Rips_complex<double> rips(points, 1.2, Euclidean_distance());
+  ST st;
+  rips.create_complex(st, 3);
+  st.initialize_filtration();
+  std::cout << "Rips complex with " << st.num_simplices() << " simplices" << std::endl;
+
+  for (int coefficient : {2, 3}) {
+    compare_with_persistent_cohomology(st, coefficient, 0., false);
+    compare_with_persistent_cohomology(st, coefficient, 0., true);
+    compare_with_persistent_cohomology(st, coefficient, 0.1, false);
+  }
+
+  Persistent_homology_matrix_reduction<ST, Field_Zp> reduction(st);
+  reduction.init_coefficients(2);
+  reduction.compute_persistent_cohomology(0.2);
+  // The Rips complex is connected at this scale
+  BOOST_CHECK(reduction.betti_number(0) == 1);
+  BOOST_CHECK(reduction.betti_numbers().size() == 3);
+
+  // Same diagram over Z/2Z with the specialized field
+  Persistent_homology_matrix_reduction<ST, Field_Z2> z2_reduction(st);
+  z2_reduction.init_coefficients(2);
+  z2_reduction.compute_persistent_cohomology(0.2);
+  for (int dim = 0; dim < 3; ++dim) {
+    auto intervals = reduction.intervals_in_dimension(dim);
+    auto z2_intervals = z2_reduction.intervals_in_dimension(dim);
+    std::sort(intervals.begin(), intervals.end());
+    std::sort(z2_intervals.begin(), z2_intervals.end());
+    BOOST_CHECK(intervals == z2_intervals);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(matrix_reduction_on_hasse_complex) {
+  std::ifstream simplex_tree_stream;
+  simplex_tree_stream.open("simplex_tree_file_for_unit_test.txt");
+  typeST st;
+  simplex_tree_stream >> st;
+  simplex_tree_stream.close();
+  st.initialize_filtration();
+  int count = 0;
+  for (auto sh : st.filtration_simplex_range())
+    st.assign_key(sh, count++);
+
+  Hasse_complex<> hcpx(st);
+  compare_with_persistent_cohomology(hcpx, 2, 0., false);
+  compare_with_persistent_cohomology(hcpx, 3, 0., true);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(matrix_reduction_on_frozen_simplex_tree, ST, list_of_tested_variants) {
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<double> coordinate(0., 1.);
+  std::vector<std::vector<double>> points(50);
+  for (auto& point : points)
+    point = {coordinate(gen), coordinate(gen), coordinate(gen)};
+  rips_complex::Rips_complex<double> rips(points, 0.4, Euclidean_distance());
+  ST st;
+  rips.create_complex(st, 3);
+
+  // Same diagram from the simplex tree and from its frozen copy
+  Persistent_cohomology<ST, Field_Zp> pcoh(st, true);
+  pcoh.init_coefficients(3);
+  pcoh.compute_persistent_cohomology(0.);
+  auto frozen = st.freeze();
+  for (int coefficient : {2, 3}) {
+    compare_with_persistent_cohomology(frozen, coefficient, 0., true);
+  }
+  Persistent_cohomology<decltype(frozen), Field_Zp> frozen_pcoh(frozen, true);
+  frozen_pcoh.init_coefficients(3);
+  frozen_pcoh.compute_persistent_cohomology(0.);
+  for (int dim = 0; dim <= static_cast<int>(st.dimension()); ++dim) {
+    auto intervals = pcoh.intervals_in_dimension(dim);
+    auto frozen_intervals = frozen_pcoh.intervals_in_dimension(dim);
+    std::sort(intervals.begin(), intervals.end());
+    std::sort(frozen_intervals.begin(), frozen_intervals.end());
+    BOOST_CHECK(intervals == frozen_intervals);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(matrix_reduction_on_cubical_complex) {
+  // Random 3D image, large enough to be reduced in several chunks
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> value(0., 1.);
+  std::vector<unsigned> sizes = {12, 12, 12};
+  std::vector<double> top_dimensional_cells(12 * 12 * 12);
+  for (double& cell : top_dimensional_cells)
+    cell = value(gen);
+
+  typedef cubical_complex::Bitmap_cubical_complex_base<double> Bitmap_base;
+  typedef cubical_complex::Bitmap_cubical_complex<Bitmap_base> Bitmap_cubical_complex;
+  Bitmap_cubical_complex cubical(sizes, top_dimensional_cells);
+  compare_with_persistent_cohomology(cubical, 2, 0., true);
+  compare_with_persistent_cohomology(cubical, 3, 0.1, true);
+
+  typedef cubical_complex::Bitmap_cubical_complex_periodic_boundary_conditions_base<double> Periodic_bitmap_base;
+  typedef cubical_complex::Bitmap_cubical_complex<Periodic_bitmap_base> Periodic_cubical_complex;
+  Periodic_cubical_complex periodic_cubical(sizes, top_dimensional_cells, std::vector<bool>(3, true));
+  compare_with_persistent_cohomology(periodic_cubical, 2, 0., true);
+  compare_with_persistent_cohomology(periodic_cubical, 3, 0., true);
+}
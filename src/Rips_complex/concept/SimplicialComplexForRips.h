@@ -34,7 +34,15 @@ struct SimplicialComplexForRips {
   /** \brief Type used to store the filtration values of the simplicial complex. */
   typedef unspecified Filtration_value;
 
-  /** \brief Inserts a given `Gudhi::rips_complex::Rips_complex::OneSkeletonGraph` in the simplicial complex. */
+  /** \brief Inserts a given `Gudhi::rips_complex::Rips_complex::OneSkeletonGraph` in the simplicial complex.
+   *
+   * `OneSkeletonGraph` is a `Gudhi::One_skeleton_csr_graph`, which is also a model of
+   * <a href="http://www.boost.org/doc/libs/1_65_1/libs/graph/doc/EdgeListGraph.html">boost::EdgeListGraph</a>
+   * whose filtration values are accessible through the property tags `vertex_filtration_t` and `edge_filtration_t`,
+   * as the `boost::adjacency_list` it replaces. A model can thus either read its compressed sparse rows directly, or
+   * use the Boost Graph interface. In the latter case, the free functions (`vertices`, `edges`, `source`, `target`,
+   * `get`...) must be called unqualified, to be found by argument-dependent lookup: unlike for the former
+   * `boost::adjacency_list`, qualified calls such as `boost::vertices(skel_graph)` do not compile. */
   template<class OneSkeletonGraph>
   void insert_graph(const OneSkeletonGraph& skel_graph);
 
@@ -58,9 +58,22 @@ namespace rips_complex {
  * In order to build this complex, the algorithm first builds the graph.
  * The filtration value of each edge is computed from a user-given distance
  * function, or directly read from the distance matrix.
+ * The pairwise distances are evaluated by cache-friendly tiles, in parallel when TBB is available. When a spatial
+ * search data structure (e.g. `Gudhi::spatial_searching::Kd_tree_search`) is given to the constructor, only the
+ * distances to the near neighbors it returns are evaluated, which is much faster for small thresholds.
  * In a second step, this graph is inserted in a simplicial complex, which then
  * gets expanded to a flag complex.
- * 
+ *
+ * When only the persistence of the Rips filtration is needed, `Rips_complex::collapse_edges()` can be called between
+ * these two steps. It removes the dominated edges of the graph, or delays them to a larger filtration value, with a
+ * `Flag_complex_edge_collapser`. The persistence diagram in dimension less than dim_max is unchanged, while the
+ * expanded complex is often smaller by orders of magnitude on dense point clouds.
+ *
+ * When only the persistence diagram is needed, `Implicit_rips_persistence` computes it without building the complex
+ * at all: the simplices are enumerated on the fly from the distance matrix, and most of them are paired without any
+ * reduction. It gives the same diagram as `Persistent_cohomology` on the complex, with a memory footprint dominated by
+ * the distance matrix.
+ *
  * The input can be given as a range of points and a distance function, or as a
  * distance matrix.
  * 
@@ -0,0 +1,224 @@
+/*    This file is part of the Gudhi Library. The Gudhi library
+ *    (Geometric Understanding in Higher Dimensions) is a generic C++
+ *    library for computational topology.
+ *
+ *    Author(s):       Gudhi contributors
+ *
+ *    Copyright (C) 2018 Inria
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FLAG_COMPLEX_EDGE_COLLAPSER_H_
+#define FLAG_COMPLEX_EDGE_COLLAPSER_H_
+
+#include <gudhi/Debug_utils.h>
+
+#include <boost/container/flat_map.hpp>
+#include <boost/container/flat_set.hpp>
+
+#include <vector>
+#include <tuple>  // for std::tuple, std::get
+#include <utility>  // for std::pair
+#include <algorithm>  // for std::sort, std::find_if, std::make_heap, std::pop_heap
+#include <iterator>  // for std::begin, std::end
+#include <stdexcept>  // for std::invalid_argument
+#include <limits>  // for std::numeric_limits
+#include <cstddef>  // for std::size_t
+
+namespace Gudhi {
+
+namespace rips_complex {
+
+/**
+ * \class Flag_complex_edge_collapser
+ * \brief Removes or delays the dominated edges of a filtered graph, without changing the persistent homology of its
+ * flag complex filtration.
+ *
+ * \ingroup rips_complex
+ *
+ * \details
+ * An edge \f$[u,v]\f$ of a graph is dominated by a vertex \f$w \neq u, v\f$ if the closed neighborhood of \f$w\f$
+ * contains the common closed neighborhood of \f$u\f$ and \f$v\f$. Removing a dominated edge is a strong collapse of
+ * the flag complex, which thus keeps its homotopy type.
+ *
+ * The edges are processed by decreasing filtration value. When an edge is dominated at the time it appears, its
+ * filtration value is increased until the time when it stops being dominated, or the edge is removed if it stays
+ * dominated until the end. The flag complex filtration of the resulting graph has the same persistence diagram as the
+ * flag complex filtration of the input graph. This is the backward algorithm of J.-D. Boissonnat and S. Pritam's edge
+ * collapse of flag complexes.
+ *
+ * As a consequence, a `Rips_complex` expanded from the collapsed graph until dimension \f$d\f$ has the same
+ * persistence as the `Rips_complex` expanded from the original graph in dimension less than \f$d\f$.
+ *
+ * \tparam Vertex_handle Integer type of the vertices.
+ * \tparam Filtration_value Type of the filtration values of the edges.
+ */
+template<typename Vertex_handle, typename Filtration_value>
+class Flag_complex_edge_collapser {
+ public:
+  /** \brief Edge \f$[u,v]\f$ and its filtration value. */
+  typedef std::tuple<Vertex_handle, Vertex_handle, Filtration_value> Filtered_edge;
+
+  /** \brief Flag_complex_edge_collapser constructor from a list of edges.
+   *
+   * @param[in] num_vertices Number of vertices of the graph, labeled from 0 to num_vertices - 1.
+   * @param[in] edges Range of `Filtered_edge`. Each edge must appear only once.
+   */
+  template<typename FilteredEdgeRange>
+  Flag_complex_edge_collapser(std::size_t num_vertices, const FilteredEdgeRange& edges)
+      : edges_(std::begin(edges), std::end(edges)),
+        neighbors_(num_vertices) {
+    // Latest edges first
+    std::sort(edges_.begin(), edges_.end(), [](const Filtered_edge& e1, const Filtered_edge& e2) {
+      return std::get<2>(e1) > std::get<2>(e2);
+    });
+
+    // Closed neighborhoods: each vertex is its own neighbor since the beginning.
+    std::vector<typename Neighbors::sequence_type> sequences(num_vertices);
+    for (std::size_t u = 0; u < num_vertices; ++u)
+      sequences[u].emplace_back(static_cast<Vertex_handle>(u), -std::numeric_limits<Filtration_value>::infinity());
+    for (const Filtered_edge& edge : edges_) {
+      Vertex_handle u = std::get<0>(edge);
+      Vertex_handle v = std::get<1>(edge);
+      GUDHI_CHECK(u != v, std::invalid_argument("Flag_complex_edge_collapser - self-loops are not simplicial"));
+      sequences[u].emplace_back(v, std::get<2>(edge));
+      sequences[v].emplace_back(u, std::get<2>(edge));
+    }
+    for (std::size_t u = 0; u < num_vertices; ++u)
+      neighbors_[u].adopt_sequence(std::move(sequences[u]));
+  }
+
+  /** \brief Collapses the edges and outputs the remaining ones, with their possibly increased filtration values.
+   *
+   * @param[in] out Output iterator on `Filtered_edge`. The edges are output by decreasing order of their original
+   * filtration value.
+   */
+  template<typename FilteredEdgeOutputIterator>
+  void collapse_edges(FilteredEdgeOutputIterator out) {
+    boost::container::flat_set<Vertex_handle> e_ngb;
+    e_ngb.reserve(neighbors_.size());
+    // Common neighbors that are connected to the edge after the current time, and when.
+    std::vector<std::pair<Filtration_value, Vertex_handle>> e_ngb_later;
+    auto later_first = [](const std::pair<Filtration_value, Vertex_handle>& n1,
+                          const std::pair<Filtration_value, Vertex_handle>& n2) {
+      return n1.first > n2.first;
+    };
+
+    for (const Filtered_edge& edge : edges_) {
+      Vertex_handle u = std::get<0>(edge);
+      Vertex_handle v = std::get<1>(edge);
+      Filtration_value time = std::get<2>(edge);
+      common_neighbors(u, v, time, e_ngb, e_ngb_later);
+      std::make_heap(e_ngb_later.begin(), e_ngb_later.end(), later_first);
+      auto later_end = e_ngb_later.end();
+
+      bool removed = false;
+      while (!removed) {
+        auto dominator = std::find_if(e_ngb.begin(), e_ngb.end(), [&](Vertex_handle w) {
+          return is_dominated_by(e_ngb, w, time);
+        });
+        if (dominator == e_ngb.end())
+          break;
+        // Delay the edge as long as it stays dominated by the same vertex, i.e. until a new common neighbor
+        // that is not a neighbor of the dominator appears.
+        Vertex_handle w = *dominator;
+        for (bool still_dominated = true; still_dominated; ) {
+          if (e_ngb_later.begin() == later_end) {
+            removed = true;
+            break;
+          }
+          time = e_ngb_later.front().first;
+          while (e_ngb_later.begin() != later_end && e_ngb_later.front().first <= time) {
+            Vertex_handle x = e_ngb_later.front().second;
+            auto it = neighbors_[w].find(x);
+            if (it == neighbors_[w].end() || it->second > time)
+              still_dominated = false;
+            e_ngb.insert(x);
+            std::pop_heap(e_ngb_later.begin(), later_end--, later_first);
+          }
+        }
+      }
+
+      if (removed) {
+        neighbors_[u].erase(v);
+        neighbors_[v].erase(u);
+      } else {
+        if (time != std::get<2>(edge)) {
+          neighbors_[u][v] = time;
+          neighbors_[v][u] = time;
+        }
+        *out++ = Filtered_edge(u, v, time);
+      }
+    }
+  }
+
+ private:
+  typedef boost::container::flat_map<Vertex_handle, Filtration_value> Neighbors;
+
+  /* Fills e_ngb with the common neighbors of u and v, other than u and v, connected to both before time, and
+   * e_ngb_later with the ones connected to both after time.*/
+  void common_neighbors(Vertex_handle u, Vertex_handle v, Filtration_value time,
+                        boost::container::flat_set<Vertex_handle>& e_ngb,
+                        std::vector<std::pair<Filtration_value, Vertex_handle>>& e_ngb_later) const {
+    e_ngb.clear();
+    e_ngb_later.clear();
+    auto u_it = neighbors_[u].begin();
+    auto u_end = neighbors_[u].end();
+    auto v_it = neighbors_[v].begin();
+    auto v_end = neighbors_[v].end();
+    while (u_it != u_end && v_it != v_end) {
+      if (u_it->first < v_it->first) {
+        ++u_it;
+      } else if (v_it->first < u_it->first) {
+        ++v_it;
+      } else {
+        Vertex_handle w = u_it->first;
+        Filtration_value fil = (std::max)(u_it->second, v_it->second);
+        if (fil > time)
+          e_ngb_later.emplace_back(fil, w);
+        else if (w != u && w != v)
+          e_ngb.insert(e_ngb.end(), w);
+        ++u_it;
+        ++v_it;
+      }
+    }
+  }
+
+  /* True if all the vertices of e_ngb are in the closed neighborhood of w at time.*/
+  bool is_dominated_by(const boost::container::flat_set<Vertex_handle>& e_ngb, Vertex_handle w,
+                       Filtration_value time) const {
+    const Neighbors& w_ngb = neighbors_[w];
+    if (w_ngb.size() < e_ngb.size())
+      return false;
+    auto w_it = w_ngb.begin();
+    auto w_end = w_ngb.end();
+    for (Vertex_handle x : e_ngb) {
+      while (w_it != w_end && w_it->first < x)
+        ++w_it;
+      if (w_it == w_end || w_it->first != x || w_it->second > time)
+        return false;
+    }
+    return true;
+  }
+
+  std::vector<Filtered_edge> edges_;
+  std::vector<Neighbors> neighbors_;
+};
+
+}  // namespace rips_complex
+
+}  // namespace Gudhi
+
+#endif  // FLAG_COMPLEX_EDGE_COLLAPSER_H_
@@ -0,0 +1,579 @@
+/*    This file is part of the Gudhi Library. The Gudhi library
+ *    (Geometric Understanding in Higher Dimensions) is a generic C++
+ *    library for computational topology.
+ *
+ *    Author(s):       Gudhi contributors
+ *
+ *    Copyright (C) 2018 Inria
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef IMPLICIT_RIPS_PERSISTENCE_H_
+#define IMPLICIT_RIPS_PERSISTENCE_H_
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <vector>
+#include <queue>  // for std::priority_queue
+#include <unordered_map>
+#include <tuple>
+#include <utility>  // for std::pair
+#include <algorithm>  // for std::sort, std::reverse, std::max
+#include <iterator>  // for std::begin, std::end, std::distance
+#include <limits>  // for std::numeric_limits
+#include <stdexcept>  // for std::invalid_argument, std::overflow_error
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdint>  // for std::int64_t
+#include <cstddef>  // for std::size_t
+
+namespace Gudhi {
+
+namespace rips_complex {
+
+/**
+ * \class Implicit_rips_persistence
+ * \brief Computes the persistent homology of a Rips filtration without building the Rips complex.
+ *
+ * \ingroup rips_complex
+ *
+ * \details
+ * The simplices are never stored in a simplicial complex. A simplex \f$\{v_0 < v_1 < \dots < v_k\}\f$ is identified by
+ * its index \f$\sum_{i=0}^{k} \binom{v_i}{i+1}\f$ in the combinatorial number system, its filtration value is computed
+ * from the distance matrix, and its cofacets are enumerated on the fly. This is the algorithm of
+ * <a target="_blank" href="https://github.com/Ripser/ripser">Ripser</a> by U. Bauer:
+ * - the persistence in dimension 0 is computed with a union-find on the edges,
+ * - in higher dimension, the coboundary matrix is reduced column by column, in reverse filtration order. Only the
+ * simplices of the current dimension are listed, and the simplices that are already paired are not (clearing). The
+ * reduced columns are not stored either: only the combinations of simplices that give them are, and their coboundaries
+ * are enumerated again when they are needed.
+ * - a simplex that has a cofacet with the same filtration value, which is not already paired, forms an emergent
+ * (or apparent) pair with it: the column of the simplex needs no reduction at all. For Rips filtrations, the vast
+ * majority of the pairs are emergent.
+ *
+ * The memory used is thus dominated by the distance matrix and the simplices of the highest dimension in which the
+ * persistence is computed, which is much less than a `Simplex_tree` containing the Rips complex. The output is the
+ * same as the one of `Persistent_cohomology` on the Rips complex created by `Rips_complex::create_complex` until the
+ * same maximal dimension.
+ *
+ * \tparam Filtration_value Type of the filtration values, i.e. of the distances.
+ */
+template<typename Filtration_value>
+class Implicit_rips_persistence {
+ public:
+  /** \brief Persistence interval, given by its dimension, birth and death. The death of an interval that never dies
+   * is infinite. */
+  typedef std::tuple<int, Filtration_value, Filtration_value> Persistent_interval;
+
+  /** \brief Implicit_rips_persistence constructor from a list of points.
+   *
+   * All the pairwise distances are computed and stored (in parallel if TBB is available).
+   *
+   * @param[in] points Range of points.
+   * @param[in] threshold Rips value.
+   * @param[in] distance distance function that returns a `Filtration_value` from 2 given points.
+   *
+   * \tparam RandomAccessPointRange must be a range for which `std::begin` and `std::end` return random access
+   * iterators on a point.
+   *
+   * \tparam Distance furnishes `operator()(const Point& p1, const Point& p2)`, where
+   * `Point` is a point from the `RandomAccessPointRange`, and that returns a `Filtration_value`.
+   */
+  template<typename RandomAccessPointRange, typename Distance>
+  Implicit_rips_persistence(const RandomAccessPointRange& points, Filtration_value threshold, Distance distance)
+      : threshold_(threshold) {
+    auto first = std::begin(points);
+    compute_distances(std::distance(first, std::end(points)), [&](std::size_t i, std::size_t j) {
+      return distance(first[i], first[j]);
+    });
+  }
+
+  /** \brief Implicit_rips_persistence constructor from a distance matrix.
+   *
+   * @param[in] distance_matrix Range of distances.
+   * @param[in] threshold Rips value.
+   *
+   * \tparam DistanceMatrix must have a `size()` method and on which `distance_matrix[i][j]` returns
+   * the distance between points \f$i\f$ and \f$j\f$ as long as \f$ 0 \leqslant j < i <
+   * distance\_matrix.size().\f$
+   */
+  template<typename DistanceMatrix>
+  Implicit_rips_persistence(const DistanceMatrix& distance_matrix, Filtration_value threshold)
+      : threshold_(threshold) {
+    compute_distances(distance_matrix.size(), [&](std::size_t i, std::size_t j) {
+      return distance_matrix[i][j];
+    });
+  }
+
+  /** \brief Initializes the coefficient field \f$\mathbb{Z}/p\mathbb{Z}\f$.
+   *
+   * @param[in] charac Characteristic \f$p\f$ of the coefficient field, a prime number.
+   * @exception std::invalid_argument If charac is not a prime number.
+   */
+  void init_coefficients(int charac) {
+    if (charac < 2)
+      throw std::invalid_argument("Implicit_rips_persistence::init_coefficients - characteristic must be prime");
+    for (int d = 2; d * d <= charac; ++d)
+      if (charac % d == 0)
+        throw std::invalid_argument("Implicit_rips_persistence::init_coefficients - characteristic must be prime");
+    modulus_ = charac;
+    // Multiplicative inverses, from p = (p / i) * i + p % i
+    inverse_.assign(charac, 0);
+    inverse_[1] = 1;
+    for (int i = 2; i < charac; ++i)
+      inverse_[i] = charac - static_cast<int>((charac / i) * static_cast<std::int64_t>(inverse_[charac % i]) % charac);
+  }
+
+  /** \brief Computes the persistent homology of the Rips filtration expanded until dimension dim_max.
+   *
+   * As for `Persistent_cohomology` on a complex of dimension dim_max, the persistence is computed in dimension 0 to
+   * dim_max - 1.
+   *
+   * @param[in] dim_max Maximal dimension of the Rips complex.
+   * @param[in] min_interval_length the computation discards all intervals of length
+   *                                less or equal than min_interval_length
+   * @exception std::overflow_error If there are too many points to index the simplices of dimension dim_max.
+   */
+  void compute_persistent_cohomology(int dim_max, Filtration_value min_interval_length = 0) {
+    persistent_pairs_.clear();
+    dim_max_ = (std::max)(dim_max, 1);
+    min_interval_length_ = min_interval_length;
+    if (num_points_ == 0)
+      return;
+    init_binomial_coefficients(dim_max_ + 1);
+
+    std::vector<Diameter_index> simplices;
+    std::vector<Diameter_index> columns_to_reduce;
+    compute_dim_0_pairs(dim_max >= 1, simplices, columns_to_reduce);
+    for (int dim = 1; dim < dim_max; ++dim) {
+      Pivot_map pivot_column_index;
+      compute_pairs(columns_to_reduce, pivot_column_index, dim);
+      if (dim + 1 < dim_max)
+        assemble_columns_to_reduce(simplices, columns_to_reduce, pivot_column_index, dim + 1, dim + 2 < dim_max);
+    }
+  }
+
+  /** \brief Output the persistence diagram in ostream.
+   *
+   * The file format is the following:
+   *    p   dim b d
+   *
+   * where "dim" is the dimension of the homological feature,
+   * b and d are respectively the birth and death of the feature and
+   * p is the characteristic of the field \f$\mathbb{Z}/p\mathbb{Z}\f$ used for homology coefficients.
+   */
+  void output_diagram(std::ostream& ostream = std::cout) {
+    sort_intervals_by_length();
+    for (const Persistent_interval& interval : persistent_pairs_) {
+      ostream << modulus_ << "  " << std::get<0>(interval) << " " << std::get<1>(interval) << " ";
+      if (std::get<2>(interval) == std::numeric_limits<Filtration_value>::infinity())
+        ostream << "inf " << std::endl;
+      else
+        ostream << std::get<2>(interval) << " " << std::endl;
+    }
+  }
+
+  /** \brief Writes the persistence diagram in the file diagram_name, one "dim b d" interval per line. */
+  void write_output_diagram(std::string diagram_name) {
+    std::ofstream diagram_out(diagram_name.c_str());
+    sort_intervals_by_length();
+    for (const Persistent_interval& interval : persistent_pairs_) {
+      diagram_out << std::get<0>(interval) << " " << std::get<1>(interval) << " ";
+      if (std::get<2>(interval) == std::numeric_limits<Filtration_value>::infinity())
+        diagram_out << "inf" << std::endl;
+      else
+        diagram_out << std::get<2>(interval) << std::endl;
+    }
+  }
+
+  /** @brief Returns Betti numbers.
+   * @return A vector of Betti numbers.
+   */
+  std::vector<int> betti_numbers() const {
+    std::vector<int> betti_numbers(dim_max_, 0);
+    for (const Persistent_interval& interval : persistent_pairs_)
+      if (std::get<2>(interval) == std::numeric_limits<Filtration_value>::infinity())
+        ++betti_numbers[std::get<0>(interval)];
+    return betti_numbers;
+  }
+
+  /** @brief Returns the Betti number of the dimension passed by parameter.
+   * @param[in] dimension The Betti number dimension to get.
+   * @return Betti number of the given dimension
+   */
+  int betti_number(int dimension) const {
+    int betti_number = 0;
+    for (const Persistent_interval& interval : persistent_pairs_)
+      if (std::get<0>(interval) == dimension &&
+          std::get<2>(interval) == std::numeric_limits<Filtration_value>::infinity())
+        ++betti_number;
+    return betti_number;
+  }
+
+  /** @brief Returns the persistence intervals.
+   * @return A vector of (dimension, birth, death) tuples.
+   */
+  const std::vector<Persistent_interval>& get_persistent_pairs() const {
+    return persistent_pairs_;
+  }
+
+  /** @brief Returns persistence intervals for a given dimension.
+   * @param[in] dimension Dimension to get the birth and death pairs from.
+   * @return A vector of persistence intervals (birth and death) on a fixed dimension.
+   */
+  std::vector<std::pair<Filtration_value, Filtration_value>> intervals_in_dimension(int dimension) const {
+    std::vector<std::pair<Filtration_value, Filtration_value>> result;
+    for (const Persistent_interval& interval : persistent_pairs_)
+      if (std::get<0>(interval) == dimension)
+        result.emplace_back(std::get<1>(interval), std::get<2>(interval));
+    return result;
+  }
+
+ private:
+  typedef int Vertex_handle;
+  typedef std::int64_t Simplex_index;
+
+  /* A simplex, given by its index, and its filtration value.*/
+  struct Diameter_index {
+    Filtration_value diameter;
+    Simplex_index index;
+  };
+
+  /* A simplex with a coefficient, in a column of the coboundary or reduction matrix.*/
+  struct Entry {
+    Filtration_value diameter;
+    Simplex_index index;
+    int coefficient;
+  };
+
+  /* The filtration order breaks ties between simplices with the same diameter by decreasing index, so that the
+   * cofacets of a simplex are enumerated in filtration order among the ones with the same diameter.*/
+  struct Comes_after_in_filtration {
+    template<typename Simplex>
+    bool operator()(const Simplex& s1, const Simplex& s2) const {
+      return s1.diameter > s2.diameter || (s1.diameter == s2.diameter && s1.index < s2.index);
+    }
+  };
+
+  /* Top of the heap is the first simplex in the filtration order.*/
+  typedef std::priority_queue<Entry, std::vector<Entry>, Comes_after_in_filtration> Column_heap;
+  /* For each pivot, the column which has this pivot in the reduced matrix, and its coefficient.*/
+  typedef std::unordered_map<Simplex_index, std::pair<std::size_t, int>> Pivot_map;
+
+  template<typename DistanceFunction>
+  void compute_distances(std::size_t num_points, DistanceFunction distance) {
+    num_points_ = num_points;
+    distances_.resize(num_points < 2 ? 0 : num_points * (num_points - 1) / 2);
+    // distances_[i * (i - 1) / 2 + j] is the distance between i and j < i, i.e. distances_ is indexed by the edges
+    auto compute_row = [&](std::size_t i) {
+      Filtration_value* row = distances_.data() + i * (i - 1) / 2;
+      for (std::size_t j = 0; j < i; ++j)
+        row[j] = distance(i, j);
+    };
+#ifdef GUDHI_USE_TBB
+    if (num_points > 1)
+      tbb::parallel_for(std::size_t(1), num_points, compute_row);
+#else
+    for (std::size_t i = 1; i < num_points; ++i)
+      compute_row(i);
+#endif
+  }
+
+  Filtration_value distance(Vertex_handle u, Vertex_handle v) const {
+    if (u < v)
+      std::swap(u, v);
+    return distances_[static_cast<std::size_t>(u) * (u - 1) / 2 + v];
+  }
+
+  /* binomial(n, k) for n <= num_points_ and k <= k_max, throws if the largest one overflows Simplex_index.*/
+  void init_binomial_coefficients(int k_max) {
+    k_max_ = k_max;
+    binomial_coefficients_.assign((num_points_ + 1) * (k_max + 1), 0);
+    for (std::size_t n = 0; n <= num_points_; ++n) {
+      binomial_coefficients_[n * (k_max + 1)] = 1;
+      for (std::size_t k = 1; k <= (std::min)(static_cast<std::size_t>(k_max), n); ++k) {
+        Simplex_index c1 = binomial_coefficients_[(n - 1) * (k_max + 1) + k - 1];
+        Simplex_index c2 = binomial_coefficients_[(n - 1) * (k_max + 1) + k];
+        if (c1 > std::numeric_limits<Simplex_index>::max() - c2)
+          throw std::overflow_error("Implicit_rips_persistence - too many points to index the simplices");
+        binomial_coefficients_[n * (k_max + 1) + k] = c1 + c2;
+      }
+    }
+  }
+
+  Simplex_index binomial(Vertex_handle n, int k) const {
+    return binomial_coefficients_[static_cast<std::size_t>(n) * (k_max_ + 1) + k];
+  }
+
+  /* Largest vertex v <= top such that binomial(v, k) <= index.*/
+  Vertex_handle max_vertex(Simplex_index index, int k, Vertex_handle top) const {
+    Vertex_handle bottom = k - 1;
+    while (bottom < top) {
+      Vertex_handle mid = bottom + (top - bottom + 1) / 2;
+      if (binomial(mid, k) <= index)
+        bottom = mid;
+      else
+        top = mid - 1;
+    }
+    return bottom;
+  }
+
+  /* Fills vertices with the vertices of the simplex of dimension dim, by decreasing label.*/
+  void simplex_vertices(Simplex_index index, int dim, std::vector<Vertex_handle>& vertices) const {
+    vertices.clear();
+    Vertex_handle top = static_cast<Vertex_handle>(num_points_) - 1;
+    for (int k = dim + 1; k > 0; --k) {
+      top = max_vertex(index, k, top);
+      vertices.push_back(top);
+      index -= binomial(top, k);
+      --top;
+    }
+  }
+
+  /* Calls visit(cofacet) for the cofacets of simplex (of dimension dim) with a diameter less than the threshold, by
+   * decreasing index, until visit returns false. The coefficient of a cofacet is the one of simplex times the
+   * incidence coefficient. When all_cofacets is false, only the cofacets obtained by adding a vertex larger than the
+   * vertices of simplex are visited, so that each simplex is the visited cofacet of exactly one of its facets.*/
+  template<typename Visitor>
+  void for_each_cofacet(const Entry& simplex, int dim, bool all_cofacets, Visitor visit) {
+    simplex_vertices(simplex.index, dim, vertices_);
+    Simplex_index index_below = simplex.index;
+    Simplex_index index_above = 0;
+    // Number of vertices of simplex larger than the added vertex
+    int j = 0;
+    for (Vertex_handle w = static_cast<Vertex_handle>(num_points_) - 1; w >= 0; --w) {
+      if (j <= dim && vertices_[j] == w) {
+        if (!all_cofacets)
+          return;
+        index_below -= binomial(w, dim + 1 - j);
+        index_above += binomial(w, dim + 2 - j);
+        ++j;
+        continue;
+      }
+      Filtration_value diameter = simplex.diameter;
+      for (Vertex_handle v : vertices_)
+        diameter = (std::max)(diameter, distance(v, w));
+      if (diameter > threshold_)
+        continue;
+      int coefficient = (j % 2 == 0) ? simplex.coefficient : modulus_ - simplex.coefficient;
+      if (!visit(Entry{diameter, index_above + binomial(w, dim + 2 - j) + index_below, coefficient}))
+        return;
+    }
+  }
+
+  void add_pair(int dim, Filtration_value birth, Filtration_value death) {
+    if (death - birth > min_interval_length_)
+      persistent_pairs_.emplace_back(dim, birth, death);
+  }
+
+  /* Persistence in dimension 0, with a union-find on the edges sorted in filtration order. The edges that do not
+   * merge two components are the columns to reduce in dimension 1, in reverse filtration order.*/
+  void compute_dim_0_pairs(bool with_edges, std::vector<Diameter_index>& edges,
+                           std::vector<Diameter_index>& columns_to_reduce) {
+    std::vector<Vertex_handle> parent(num_points_);
+    for (std::size_t u = 0; u < num_points_; ++u)
+      parent[u] = static_cast<Vertex_handle>(u);
+    auto find = [&](Vertex_handle u) {
+      while (parent[u] != u) {
+        parent[u] = parent[parent[u]];
+        u = parent[u];
+      }
+      return u;
+    };
+
+    edges.clear();
+    columns_to_reduce.clear();
+    if (with_edges) {
+      for (std::size_t index = 0; index < distances_.size(); ++index)
+        if (distances_[index] <= threshold_)
+          edges.push_back(Diameter_index{distances_[index], static_cast<Simplex_index>(index)});
+      std::sort(edges.begin(), edges.end(), [](const Diameter_index& e1, const Diameter_index& e2) {
+        return Comes_after_in_filtration()(e2, e1);
+      });
+    }
+
+    for (const Diameter_index& edge : edges) {
+      simplex_vertices(edge.index, 1, vertices_);
+      Vertex_handle u = find(vertices_[0]);
+      Vertex_handle v = find(vertices_[1]);
+      if (u != v) {
+        // All the vertices are born at 0, the younger component is the one with the larger root
+        parent[(std::max)(u, v)] = (std::min)(u, v);
+        add_pair(0, 0, edge.diameter);
+      } else {
+        columns_to_reduce.push_back(edge);
+      }
+    }
+    for (std::size_t u = 0; u < num_points_; ++u)
+      if (parent[u] == static_cast<Vertex_handle>(u))
+        persistent_pairs_.emplace_back(0, 0, std::numeric_limits<Filtration_value>::infinity());
+    std::reverse(columns_to_reduce.begin(), columns_to_reduce.end());
+  }
+
+  /* Lists in columns_to_reduce the simplices of dimension dim that are not the pivot of a reduced column, in reverse
+   * filtration order, from the list of simplices of dimension dim - 1. If keep_simplices is true, simplices is
+   * replaced with the list of simplices of dimension dim, for the next dimension.*/
+  void assemble_columns_to_reduce(std::vector<Diameter_index>& simplices,
+                                  std::vector<Diameter_index>& columns_to_reduce,
+                                  const Pivot_map& pivot_column_index, int dim, bool keep_simplices) {
+    std::vector<Diameter_index> next_simplices;
+    columns_to_reduce.clear();
+    for (const Diameter_index& simplex : simplices) {
+      for_each_cofacet(Entry{simplex.diameter, simplex.index, 1}, dim - 1, false, [&](const Entry& cofacet) {
+        if (keep_simplices)
+          next_simplices.push_back(Diameter_index{cofacet.diameter, cofacet.index});
+        if (pivot_column_index.find(cofacet.index) == pivot_column_index.end())
+          columns_to_reduce.push_back(Diameter_index{cofacet.diameter, cofacet.index});
+        return true;
+      });
+    }
+    simplices.swap(next_simplices);
+    std::sort(columns_to_reduce.begin(), columns_to_reduce.end(), Comes_after_in_filtration());
+  }
+
+  /* Removes the first entry of column in the filtration order with a non zero coefficient, after summing the entries
+   * of the same simplex. Returns false if the column is zero.*/
+  bool pop_pivot(Column_heap& column, Entry& pivot) const {
+    while (!column.empty()) {
+      pivot = column.top();
+      column.pop();
+      while (!column.empty() && column.top().index == pivot.index) {
+        pivot.coefficient = (pivot.coefficient + column.top().coefficient) % modulus_;
+        column.pop();
+      }
+      if (pivot.coefficient != 0)
+        return true;
+    }
+    return false;
+  }
+
+  bool get_pivot(Column_heap& column, Entry& pivot) const {
+    if (!pop_pivot(column, pivot))
+      return false;
+    column.push(pivot);
+    return true;
+  }
+
+  int multiply(int a, int b) const {
+    return static_cast<int>(static_cast<std::int64_t>(a) * b % modulus_);
+  }
+
+  /* Reduces the coboundary matrix of the simplices of dimension dim in columns_to_reduce, and fills
+   * pivot_column_index with the pivots of the reduced columns.*/
+  void compute_pairs(const std::vector<Diameter_index>& columns_to_reduce, Pivot_map& pivot_column_index, int dim) {
+    // The reduction matrix: column i is the linear combination of simplices whose coboundary is reduced column i.
+    std::vector<Entry> reduction_entries;
+    std::vector<std::size_t> reduction_begin(columns_to_reduce.size() + 1, 0);
+    pivot_column_index.reserve(columns_to_reduce.size());
+
+    Column_heap working_reduction_column;
+    Column_heap working_coboundary;
+    for (std::size_t i = 0; i < columns_to_reduce.size(); ++i) {
+      const Entry column{columns_to_reduce[i].diameter, columns_to_reduce[i].index, 1};
+      working_reduction_column = Column_heap();
+      working_coboundary = Column_heap();
+      working_reduction_column.push(column);
+
+      Entry pivot;
+      bool has_pivot = init_coboundary_and_get_pivot(column, dim, working_coboundary, pivot_column_index, pivot);
+      while (has_pivot) {
+        auto other = pivot_column_index.find(pivot.index);
+        if (other == pivot_column_index.end())
+          break;
+        // Eliminate the pivot with the reduced column that has the same one
+        std::size_t j = other->second.first;
+        int factor = modulus_ - multiply(pivot.coefficient, inverse_[other->second.second]);
+        for (std::size_t k = reduction_begin[j]; k < reduction_begin[j + 1]; ++k) {
+          Entry simplex = reduction_entries[k];
+          simplex.coefficient = multiply(simplex.coefficient, factor);
+          working_reduction_column.push(simplex);
+          for_each_cofacet(simplex, dim, true, [&](const Entry& cofacet) {
+            working_coboundary.push(cofacet);
+            return true;
+          });
+        }
+        has_pivot = get_pivot(working_coboundary, pivot);
+      }
+
+      if (has_pivot) {
+        add_pair(dim, column.diameter, pivot.diameter);
+        pivot_column_index.emplace(pivot.index, std::make_pair(i, pivot.coefficient));
+        // Only the columns with a pivot may be used to reduce the next ones
+        Entry simplex;
+        while (pop_pivot(working_reduction_column, simplex))
+          reduction_entries.push_back(simplex);
+      } else {
+        persistent_pairs_.emplace_back(dim, column.diameter, std::numeric_limits<Filtration_value>::infinity());
+      }
+      reduction_begin[i + 1] = reduction_entries.size();
+    }
+  }
+
+  /* Fills working_coboundary with the coboundary of column and returns its pivot. When the first cofacet with the
+   * same diameter as column is not already a pivot, it is the pivot of column and the rest of the coboundary is not
+   * needed: this is an emergent pair.*/
+  bool init_coboundary_and_get_pivot(const Entry& column, int dim, Column_heap& working_coboundary,
+                                     const Pivot_map& pivot_column_index, Entry& pivot) {
+    bool check_for_emergent_pair = true;
+    bool emergent_pair = false;
+    for_each_cofacet(column, dim, true, [&](const Entry& cofacet) {
+      working_coboundary.push(cofacet);
+      if (check_for_emergent_pair && cofacet.diameter == column.diameter) {
+        if (pivot_column_index.find(cofacet.index) == pivot_column_index.end()) {
+          pivot = cofacet;
+          emergent_pair = true;
+          return false;
+        }
+        check_for_emergent_pair = false;
+      }
+      return true;
+    });
+    if (emergent_pair)
+      return true;
+    return get_pivot(working_coboundary, pivot);
+  }
+
+  /* Longest intervals first, as Persistent_cohomology does.*/
+  void sort_intervals_by_length() {
+    std::stable_sort(persistent_pairs_.begin(), persistent_pairs_.end(),
+                     [](const Persistent_interval& p1, const Persistent_interval& p2) {
+      return std::get<2>(p1) - std::get<1>(p1) > std::get<2>(p2) - std::get<1>(p2);
+    });
+  }
+
+ private:
+  std::size_t num_points_;
+  Filtration_value threshold_;
+  /* Lower triangle of the distance matrix, indexed by the edges.*/
+  std::vector<Filtration_value> distances_;
+  std::vector<Simplex_index> binomial_coefficients_;
+  int k_max_ = 0;
+  int modulus_ = 2;
+  std::vector<int> inverse_ = {0, 1};
+  int dim_max_ = 1;
+  Filtration_value min_interval_length_ = 0;
+  std::vector<Persistent_interval> persistent_pairs_;
+  /* Buffer for the vertices of a simplex.*/
+  std::vector<Vertex_handle> vertices_;
+};
+
+}  // namespace rips_complex
+
+}  // namespace Gudhi
+
+#endif  // IMPLICIT_RIPS_PERSISTENCE_H_
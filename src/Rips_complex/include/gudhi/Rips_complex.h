@@ -25,8 +25,19 @@
 
 #include <gudhi/Debug_utils.h>
 #include <gudhi/graph_simplicial_complex.h>
+#include <gudhi/distance_functions.h>
+#include <gudhi/One_skeleton_csr_graph.h>
+#include <gudhi/Flag_complex_edge_collapser.h>
+#include <gudhi/Rips_complex/Edge_buffer.h>
 
-#include <boost/graph/adjacency_list.hpp>
+#include <boost/range/irange.hpp>
+#include <boost/iterator/function_output_iterator.hpp>
+#include <boost/iterator/iterator_categories.hpp>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/enumerable_thread_specific.h>
+#endif
 
 #include <iostream>
 #include <vector>
@@ -34,6 +45,12 @@
 #include <string>
 #include <limits>  // for numeric_limits
 #include <utility>  // for pair<>
+#include <tuple>  // for std::get
+#include <iterator>  // for std::begin, std::distance, std::back_inserter
+#include <type_traits>  // for std::is_same, std::integral_constant
+#include <algorithm>  // for std::min, std::max, std::fill
+#include <cmath>  // for std::sqrt
+#include <cstddef>  // for std::size_t
 
 
 namespace Gudhi {
@@ -55,16 +72,19 @@ namespace rips_complex {
  */
 template<typename Filtration_value>
 class Rips_complex {
+ private:
+  typedef int Vertex_handle;
+
  public:
   /**
    * \brief Type of the one skeleton graph stored inside the Rips complex structure.
    */
-  typedef typename boost::adjacency_list < boost::vecS, boost::vecS, boost::undirectedS
-  , boost::property < vertex_filtration_t, Filtration_value >
-  , boost::property < edge_filtration_t, Filtration_value >> OneSkeletonGraph;
+  typedef One_skeleton_csr_graph<Filtration_value, Vertex_handle> OneSkeletonGraph;
 
  private:
-  typedef int Vertex_handle;
+
+  /* Edges of the proximity graph and their filtration values, as found by one thread.*/
+  typedef internal::Edge_buffer<Vertex_handle, Filtration_value> Edge_buffer;
 
  public:
   /** \brief Rips_complex constructor from a list of points.
@@ -73,8 +93,9 @@ class Rips_complex {
    * @param[in] threshold Rips value.
    * @param[in] distance distance function that returns a `Filtration_value` from 2 given points.
    * 
-   * \tparam ForwardPointRange must be a range for which `std::begin` and `std::end` return input iterators on a
-   * point.
+   * \tparam ForwardPointRange must be a range for which `std::begin` and `std::end` return forward iterators on a
+   * point. The points are accessed by their index, so they are first copied in a vector when the iterators are not
+   * random access.
    *
    * \tparam Distance furnishes `operator()(const Point& p1, const Point& p2)`, where
    * `Point` is a point from the `ForwardPointRange`, and that returns a `Filtration_value`.
@@ -84,6 +105,34 @@ class Rips_complex {
     compute_proximity_graph(points, threshold, distance);
   }
 
+  /** \brief Rips_complex constructor from a list of points, where the candidate edges are given by a spatial search
+   * data structure.
+   *
+   * Only the pairs of points returned by `neighbor_search` are evaluated with `distance`. This is much faster than
+   * evaluating all the pairwise distances when the threshold is small compared to the diameter of the point cloud.
+   *
+   * @param[in] points Range of points.
+   * @param[in] threshold Rips value.
+   * @param[in] distance distance function that returns a `Filtration_value` from 2 given points.
+   * @param[in] neighbor_search Spatial search data structure built on `points`, e.g.
+   * `Gudhi::spatial_searching::Kd_tree_search`.
+   *
+   * \tparam RandomAccessPointRange must be a range for which `std::begin` and `std::end` return random access
+   * iterators on a point.
+   *
+   * \tparam Distance furnishes `operator()(const Point& p1, const Point& p2)`, where
+   * `Point` is a point from the `RandomAccessPointRange`, and that returns a `Filtration_value`.
+   *
+   * \tparam NeighborSearch furnishes `all_near_neighbors(const Point& p, Filtration_value radius, OutputIterator it)`,
+   * that outputs in `it` the indices in `points` of (at least) all the points at distance at most `radius` from `p`.
+   * The `Kd_tree_search` Euclidean metric fulfills this requirement for `Gudhi::Euclidean_distance`.
+   */
+  template<typename RandomAccessPointRange, typename Distance, typename NeighborSearch>
+  Rips_complex(const RandomAccessPointRange& points, Filtration_value threshold, Distance distance,
+               const NeighborSearch& neighbor_search) {
+    compute_proximity_graph(points, threshold, distance, neighbor_search);
+  }
+
   /** \brief Rips_complex constructor from a distance matrix.
    *
    * @param[in] distance_matrix Range of distances.
@@ -99,6 +148,33 @@ class Rips_complex {
                             [&](size_t i, size_t j){return distance_matrix[j][i];});
   }
 
+  /** \brief Removes or delays the edges of the Rips graph that do not change the persistent homology of the Rips
+   * filtration.
+   *
+   * The edges are collapsed with a `Flag_complex_edge_collapser`. A complex created afterwards with `create_complex`
+   * until a given maximal dimension \f$d\f$ can be much smaller, and has the same persistence diagram in dimension
+   * less than \f$d\f$. The simplices of the resulting complex are not the ones of the Rips complex though, as some
+   * edges (and the simplices containing them) are missing or appear later.
+   */
+  void collapse_edges() {
+    typedef Flag_complex_edge_collapser<Vertex_handle, Filtration_value> Edge_collapser;
+    std::vector<typename Edge_collapser::Filtered_edge> filtered_edges;
+    filtered_edges.reserve(rips_skeleton_graph_.num_edges());
+    for (std::size_t u = 0; u < rips_skeleton_graph_.num_vertices(); ++u) {
+      auto fil_it = rips_skeleton_graph_.upper_edge_filtrations(u).begin();
+      for (Vertex_handle v : rips_skeleton_graph_.upper_neighbors(u))
+        filtered_edges.emplace_back(static_cast<Vertex_handle>(u), v, *fil_it++);
+    }
+
+    Edge_buffer remaining_edges;
+    Edge_collapser(rips_skeleton_graph_.num_vertices(), filtered_edges)
+        .collapse_edges(boost::make_function_output_iterator([&](const typename Edge_collapser::Filtered_edge& edge) {
+          remaining_edges.push_back(std::get<0>(edge), std::get<1>(edge), std::get<2>(edge));
+        }));
+    rips_skeleton_graph_ = OneSkeletonGraph(rips_skeleton_graph_.num_vertices(), remaining_edges.edges,
+                                            remaining_edges.edges_fil);
+  }
+
   /** \brief Initializes the simplicial complex from the Rips graph and expands it until a given maximal
    * dimension.
    *
@@ -126,8 +202,8 @@ class Rips_complex {
    * If points contains n elements, the proximity graph is the graph with n vertices, and an edge [u,v] iff the
    * distance function between points u and v is smaller than threshold.
    *
-   * \tparam ForwardPointRange furnishes `.begin()` and `.end()`
-   * methods.
+   * \tparam ForwardPointRange furnishes `.begin()` and `.end()` methods, that return forward iterators. The points
+   * are copied in a vector when they are not random access iterators.
    *
    * \tparam Distance furnishes `operator()(const Point& p1, const Point& p2)`, where
    * `Point` is a point from the `ForwardPointRange`, and that returns a `Filtration_value`.
@@ -135,45 +211,164 @@ class Rips_complex {
   template< typename ForwardPointRange, typename Distance >
   void compute_proximity_graph(const ForwardPointRange& points, Filtration_value threshold,
                Distance distance) {
-    std::vector< std::pair< Vertex_handle, Vertex_handle > > edges;
-    std::vector< Filtration_value > edges_fil;
-
-    // Compute the proximity graph of the points.
-    // If points contains n elements, the proximity graph is the graph with n vertices, and an edge [u,v] iff the
-    // distance function between points u and v is smaller than threshold.
-    // --------------------------------------------------------------------------------------------
-    // Creates the vector of edges and its filtration values (returned by distance function)
-    Vertex_handle idx_u = 0;
-    for (auto it_u = std::begin(points); it_u != std::end(points); ++it_u, ++idx_u) {
-      Vertex_handle idx_v = idx_u + 1;
-      for (auto it_v = it_u + 1; it_v != std::end(points); ++it_v, ++idx_v) {
-        Filtration_value fil = distance(*it_u, *it_v);
-        if (fil <= threshold) {
-          edges.emplace_back(idx_u, idx_v);
-          edges_fil.push_back(fil);
+    typedef decltype(std::begin(points)) Point_iterator;
+    typedef typename boost::iterator_traversal<Point_iterator>::type Point_traversal;
+    compute_tiled_proximity_graph(points, threshold, distance,
+                                  std::is_convertible<Point_traversal, boost::random_access_traversal_tag>());
+  }
+
+  template< typename ForwardPointRange, typename Distance >
+  void compute_tiled_proximity_graph(const ForwardPointRange& points, Filtration_value threshold,
+                                     Distance& distance, std::false_type) {
+    typedef typename std::decay<decltype(*std::begin(points))>::type Point;
+    std::vector<Point> point_cloud(std::begin(points), std::end(points));
+    compute_tiled_proximity_graph(point_cloud, threshold, distance, std::true_type());
+  }
+
+  /* The strict upper triangle of the distance matrix is cut into square tiles, small enough for the points of a tile
+   * to stay in cache. The tiles are processed independently (in parallel if TBB is available).*/
+  template< typename RandomAccessPointRange, typename Distance >
+  void compute_tiled_proximity_graph(const RandomAccessPointRange& points, Filtration_value threshold,
+                                     Distance& distance, std::true_type) {
+    auto first = std::begin(points);
+    const std::size_t num_points = std::distance(first, std::end(points));
+    const std::size_t tile_size = 256;
+    const std::size_t num_tile_rows = (num_points + tile_size - 1) / tile_size;
+
+    // Tiles (row, column) with row <= column, i.e. the ones that intersect the strict upper triangle.
+    std::vector< std::pair< std::size_t, std::size_t > > tiles;
+    tiles.reserve(num_tile_rows * (num_tile_rows + 1) / 2);
+    for (std::size_t row = 0; row < num_tile_rows; ++row)
+      for (std::size_t column = row; column < num_tile_rows; ++column)
+        tiles.emplace_back(row, column);
+
+    typedef typename std::decay<decltype(*first)>::type Point;
+    build_proximity_graph(tiles.size(), num_points, [&](std::size_t tile, Edge_buffer& buffer) {
+      std::size_t row_begin = tiles[tile].first * tile_size;
+      std::size_t column_begin = tiles[tile].second * tile_size;
+      compute_tile(first, distance, threshold,
+                   row_begin, (std::min)(row_begin + tile_size, num_points),
+                   column_begin, (std::min)(column_begin + tile_size, num_points),
+                   buffer, Is_euclidean_on_vectors_of_double<Distance, Point>());
+    });
+  }
+
+  /** \brief Computes the proximity graph of the points, only evaluating the distances to the neighbors returned by
+   * a spatial search data structure.
+   */
+  template< typename RandomAccessPointRange, typename Distance, typename NeighborSearch >
+  void compute_proximity_graph(const RandomAccessPointRange& points, Filtration_value threshold,
+               Distance distance, const NeighborSearch& neighbor_search) {
+    auto first = std::begin(points);
+    const std::size_t num_points = std::distance(first, std::end(points));
+
+    build_proximity_graph(num_points, num_points, [&](std::size_t u, Edge_buffer& buffer) {
+      thread_local std::vector< std::size_t > neighbors;
+      neighbors.clear();
+      neighbor_search.all_near_neighbors(first[u], threshold, std::back_inserter(neighbors));
+      for (std::size_t v : neighbors) {
+        // Each edge is found twice, keep it only from its lower end.
+        if (v > u) {
+          Filtration_value fil = distance(first[u], first[v]);
+          if (fil <= threshold)
+            buffer.push_back(u, v, fil);
         }
       }
+    });
+  }
+
+  /* True if the Euclidean distance is computed on std::vector<double>, for which the tiles have a faster version.*/
+  template< typename Distance, typename Point >
+  using Is_euclidean_on_vectors_of_double = std::integral_constant<bool,
+      std::is_same<Distance, Euclidean_distance>::value && std::is_same<Point, std::vector<double>>::value>;
+
+  /* Pushes in buffer all the edges [u,v] with u < v, u in [row_begin, row_end) and v in [column_begin, column_end),
+   * which length is smaller than threshold.*/
+  template< typename PointIterator, typename Distance >
+  static void compute_tile(PointIterator first, Distance& distance, Filtration_value threshold,
+                           std::size_t row_begin, std::size_t row_end,
+                           std::size_t column_begin, std::size_t column_end,
+                           Edge_buffer& buffer, std::false_type) {
+    for (std::size_t u = row_begin; u < row_end; ++u) {
+      for (std::size_t v = (std::max)(u + 1, column_begin); v < column_end; ++v) {
+        Filtration_value fil = distance(first[u], first[v]);
+        if (fil <= threshold)
+          buffer.push_back(u, v, fil);
+      }
+    }
+  }
+
+  /* Same as above for the Euclidean distance on std::vector<double>. The coordinates of the points of the columns
+   * are transposed, so that the innermost loop runs over independent pairs of points and can be vectorized by the
+   * compiler. Each squared distance is summed in the same order as in Euclidean_distance, which gives the same
+   * result.*/
+  template< typename PointIterator >
+  static void compute_tile(PointIterator first, Euclidean_distance&, Filtration_value threshold,
+                           std::size_t row_begin, std::size_t row_end,
+                           std::size_t column_begin, std::size_t column_end,
+                           Edge_buffer& buffer, std::true_type) {
+    const std::size_t dim = first[column_begin].size();
+    const std::size_t width = column_end - column_begin;
+    // columns[d * width + j] is the d-th coordinate of the point column_begin + j
+    thread_local std::vector<double> columns;
+    thread_local std::vector<double> squared_distances;
+    columns.resize(dim * width);
+    squared_distances.resize(width);
+    for (std::size_t j = 0; j < width; ++j) {
+      const std::vector<double>& p_v = first[column_begin + j];
+      GUDHI_CHECK(p_v.size() == dim, "inconsistent point dimensions");
+      for (std::size_t d = 0; d < dim; ++d)
+        columns[d * width + j] = p_v[d];
     }
 
-    // --------------------------------------------------------------------------------------------
-    // Creates the proximity graph from edges and sets the property with the filtration value.
-    // Number of points is labeled from 0 to idx_u-1
-    // --------------------------------------------------------------------------------------------
-    // Do not use : rips_skeleton_graph_ = OneSkeletonGraph(...) -> deep copy of the graph (boost graph is not
-    // move-enabled)
-    rips_skeleton_graph_.~OneSkeletonGraph();
-    new(&rips_skeleton_graph_)OneSkeletonGraph(edges.begin(), edges.end(), edges_fil.begin(), idx_u);
-
-    auto vertex_prop = boost::get(vertex_filtration_t(), rips_skeleton_graph_);
-
-    using vertex_iterator = typename boost::graph_traits<OneSkeletonGraph>::vertex_iterator;
-    vertex_iterator vi, vi_end;
-    for (std::tie(vi, vi_end) = boost::vertices(rips_skeleton_graph_);
-         vi != vi_end; ++vi) {
-      boost::put(vertex_prop, *vi, 0.);
+    for (std::size_t u = row_begin; u < row_end; ++u) {
+      const std::vector<double>& p_u = first[u];
+      GUDHI_CHECK(p_u.size() == dim, "inconsistent point dimensions");
+      // Only consider v > u on the tiles of the diagonal
+      std::size_t j_begin = (u < column_begin) ? 0 : u + 1 - column_begin;
+      if (j_begin >= width)
+        continue;
+      double* dist = squared_distances.data();
+      std::fill(dist + j_begin, dist + width, 0.);
+      for (std::size_t d = 0; d < dim; ++d) {
+        const double x = p_u[d];
+        const double* column = columns.data() + d * width;
+        for (std::size_t j = j_begin; j < width; ++j) {
+          double tmp = x - column[j];
+          dist[j] += tmp * tmp;
+        }
+      }
+      for (std::size_t j = j_begin; j < width; ++j) {
+        Filtration_value fil = std::sqrt(dist[j]);
+        if (fil <= threshold)
+          buffer.push_back(u, column_begin + j, fil);
+      }
     }
   }
 
+  /** \brief Creates the proximity graph from the edges found by compute_task(task, buffer) for all task in
+   * [0, num_tasks).
+   *
+   * The tasks are run in parallel if TBB is available, each thread pushing edges in its own buffer.
+   */
+  template< typename ComputeTask >
+  void build_proximity_graph(std::size_t num_tasks, std::size_t num_points, ComputeTask compute_task) {
+    Edge_buffer all_edges;
+#ifdef GUDHI_USE_TBB
+    tbb::enumerable_thread_specific<Edge_buffer> thread_edges;
+    tbb::parallel_for(std::size_t(0), num_tasks, [&](std::size_t task) {
+      compute_task(task, thread_edges.local());
+    });
+    all_edges.append(thread_edges);
+#else
+    for (std::size_t task = 0; task < num_tasks; ++task)
+      compute_task(task, all_edges);
+#endif
+
+    // Points are labeled from 0 to num_points-1
+    rips_skeleton_graph_ = OneSkeletonGraph(num_points, all_edges.edges, all_edges.edges_fil);
+  }
+
  private:
   OneSkeletonGraph rips_skeleton_graph_;
 };
@@ -0,0 +1,69 @@
+/*    This file is part of the Gudhi Library. The Gudhi library
+ *    (Geometric Understanding in Higher Dimensions) is a generic C++
+ *    library for computational topology.
+ *
+ *    Author(s):       Gudhi contributors
+ *
+ *    Copyright (C) 2018 Inria
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RIPS_COMPLEX_EDGE_BUFFER_H_
+#define RIPS_COMPLEX_EDGE_BUFFER_H_
+
+#include <vector>
+#include <utility>  // for std::pair
+#include <cstddef>  // for std::size_t
+
+namespace Gudhi {
+
+namespace rips_complex {
+
+namespace internal {
+
+/* Edges of a one-skeleton graph and their filtration values, in the format of the One_skeleton_csr_graph constructor.
+ * Each thread that computes edges pushes them in its own buffer, and the buffers are then appended to one another.*/
+template <typename Vertex_handle, typename Filtration_value>
+struct Edge_buffer {
+  void push_back(std::size_t u, std::size_t v, Filtration_value fil) {
+    edges.emplace_back(static_cast<Vertex_handle>(u), static_cast<Vertex_handle>(v));
+    edges_fil.push_back(fil);
+  }
+
+  /* Appends the edges of all the buffers of a range, e.g. a tbb::enumerable_thread_specific<Edge_buffer>.*/
+  template <typename BufferRange>
+  void append(BufferRange& buffers) {
+    std::size_t num_edges = edges.size();
+    for (auto& buffer : buffers)
+      num_edges += buffer.edges.size();
+    edges.reserve(num_edges);
+    edges_fil.reserve(num_edges);
+    for (auto& buffer : buffers) {
+      edges.insert(edges.end(), buffer.edges.begin(), buffer.edges.end());
+      edges_fil.insert(edges_fil.end(), buffer.edges_fil.begin(), buffer.edges_fil.end());
+    }
+  }
+
+  std::vector<std::pair<Vertex_handle, Vertex_handle>> edges;
+  std::vector<Filtration_value> edges_fil;
+};
+
+}  // namespace internal
+
+}  // namespace rips_complex
+
+}  // namespace Gudhi
+
+#endif  // RIPS_COMPLEX_EDGE_BUFFER_H_
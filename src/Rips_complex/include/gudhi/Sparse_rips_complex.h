@@ -26,10 +26,16 @@
 #include <gudhi/Debug_utils.h>
 #include <gudhi/graph_simplicial_complex.h>
 #include <gudhi/choose_n_farthest_points.h>
+#include <gudhi/One_skeleton_csr_graph.h>
+#include <gudhi/Rips_complex/Edge_buffer.h>
 
-#include <boost/graph/adjacency_list.hpp>
 #include <boost/range/metafunctions.hpp>
 
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/enumerable_thread_specific.h>
+#endif
+
 #include <vector>
 
 namespace Gudhi {
@@ -54,14 +60,13 @@ namespace rips_complex {
 template <typename Filtration_value>
 class Sparse_rips_complex {
  private:
-  // TODO: use a different graph where we know we can safely insert in parallel.
-  typedef typename boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS,
-                                         boost::property<vertex_filtration_t, Filtration_value>,
-                                         boost::property<edge_filtration_t, Filtration_value>>
-      Graph;
-
   typedef int Vertex_handle;
 
+  typedef One_skeleton_csr_graph<Filtration_value, Vertex_handle> Graph;
+
+  /* Edges of the sparse graph and their filtration values, as found by one thread.*/
+  typedef internal::Edge_buffer<Vertex_handle, Filtration_value> Edge_buffer;
+
  public:
   /** \brief Sparse_rips_complex constructor from a list of points.
    *
@@ -130,20 +135,9 @@ class Sparse_rips_complex {
   template <typename PointRange, typename ParamRange, typename Distance>
   void compute_sparse_graph(const PointRange& points, const ParamRange& params, Distance& dist, double epsilon) {
     const int n = boost::size(points);
-    graph_.~Graph();
-    new (&graph_) Graph(n);
-    // for(auto v : vertices(g)) // doesn't work :-(
-    typename boost::graph_traits<Graph>::vertex_iterator v_i, v_e;
-    for (std::tie(v_i, v_e) = vertices(graph_); v_i != v_e; ++v_i) {
-      auto v = *v_i;
-      // This whole loop might not be necessary, leave it until someone investigates if it is safe to remove.
-      put(vertex_filtration_t(), graph_, v, 0);
-    }
-
-    // TODO:
-    // - make it parallel
-    // - only test near-enough neighbors
-    for (int i = 0; i < n; ++i)
+
+    // TODO: only test near-enough neighbors
+    auto compute_row = [&](int i, Edge_buffer& buffer) {
       for (int j = i + 1; j < n; ++j) {
         auto&& pi = points[i];
         auto&& pj = points[j];
@@ -161,8 +155,21 @@ class Sparse_rips_complex {
         else
           continue;
 
-        add_edge(pi, pj, alpha, graph_);
+        buffer.push_back(pi, pj, alpha);
       }
+    };
+
+    Edge_buffer all_edges;
+#ifdef GUDHI_USE_TBB
+    tbb::enumerable_thread_specific<Edge_buffer> thread_edges;
+    tbb::parallel_for(0, n, [&](int i) { compute_row(i, thread_edges.local()); });
+    all_edges.append(thread_edges);
+#else
+    for (int i = 0; i < n; ++i)
+      compute_row(i, all_edges);
+#endif
+
+    graph_ = Graph(n, all_edges.edges, all_edges.edges_fil);
   }
 
   Graph graph_;
@@ -28,16 +28,21 @@
 #include <limits>
 #include <string>
 #include <vector>
+#include <list>
 #include <algorithm>    // std::max
+#include <random>
+#include <cstddef>  // for std::size_t
 
 #include <gudhi/Rips_complex.h>
 #include <gudhi/Sparse_rips_complex.h>
+#include <gudhi/Implicit_rips_persistence.h>
 // to construct Rips_complex from a OFF file of points
 #include <gudhi/Points_off_io.h>
 #include <gudhi/Simplex_tree.h>
 #include <gudhi/distance_functions.h>
 #include <gudhi/reader_utils.h>
 #include <gudhi/Unitary_tests_utils.h>
+#include <gudhi/Persistent_cohomology.h>
 
 // Type definitions
 using Point = std::vector<double>;
@@ -232,6 +237,50 @@ BOOST_AUTO_TEST_CASE(Rips_complex_from_points) {
   }
 }
 
+// Model of SimplicialComplexForRips that only knows the Boost Graph interface of the one-skeleton graph,
+// whose free functions are found by argument-dependent lookup
+struct Boost_graph_complex {
+  typedef Simplex_tree::Filtration_value Filtration_value;
+  Simplex_tree st;
+
+  template <class OneSkeletonGraph>
+  void insert_graph(const OneSkeletonGraph& skel_graph) {
+    typename boost::graph_traits<OneSkeletonGraph>::vertex_iterator v_it, v_it_end;
+    for (std::tie(v_it, v_it_end) = vertices(skel_graph); v_it != v_it_end; ++v_it)
+      st.insert_simplex({*v_it}, get(Gudhi::vertex_filtration_t(), skel_graph, *v_it));
+    typename boost::graph_traits<OneSkeletonGraph>::edge_iterator e_it, e_it_end;
+    for (std::tie(e_it, e_it_end) = edges(skel_graph); e_it != e_it_end; ++e_it)
+      st.insert_simplex({static_cast<int>(source(*e_it, skel_graph)), static_cast<int>(target(*e_it, skel_graph))},
+                        get(Gudhi::edge_filtration_t(), skel_graph, *e_it));
+  }
+
+  void expansion(int max_dim) { st.expansion(max_dim); }
+
+  std::size_t num_vertices() { return st.num_vertices(); }
+};
+
+BOOST_AUTO_TEST_CASE(Rips_complex_boost_graph_model) {
+  std::vector<Point> points;
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> coord(0., 1.);
+  for (int i = 0; i < 30; ++i)
+    points.push_back({coord(gen), coord(gen)});
+
+  Rips_complex rips_complex_from_points(points, 0.4, Gudhi::Euclidean_distance());
+  Simplex_tree st;
+  rips_complex_from_points.create_complex(st, 3);
+  Boost_graph_complex boost_graph_complex;
+  rips_complex_from_points.create_complex(boost_graph_complex, 3);
+  BOOST_CHECK(st == boost_graph_complex.st);
+
+  Sparse_rips_complex sparse_rips(points, Gudhi::Euclidean_distance(), 0.5);
+  Simplex_tree sparse_st;
+  sparse_rips.create_complex(sparse_st, 3);
+  Boost_graph_complex sparse_boost_graph_complex;
+  sparse_rips.create_complex(sparse_boost_graph_complex, 3);
+  BOOST_CHECK(sparse_st == sparse_boost_graph_complex.st);
+}
+
 BOOST_AUTO_TEST_CASE(Sparse_rips_complex_from_points) {
   // This is a clone of the test above
   // ----------------------------------------------------------------------------
@@ -392,6 +441,195 @@ BOOST_AUTO_TEST_CASE(Rips_doc_csv_file) {
 
 }
 
+// Brute force model of the NeighborSearch concept, returns the indices of all the points in the ball.
+class Brute_force_neighbor_search {
+ public:
+  explicit Brute_force_neighbor_search(const Vector_of_points& points) : points_(points) { }
+
+  template <typename OutputIterator>
+  void all_near_neighbors(const Point& p, double radius, OutputIterator it) const {
+    for (std::size_t idx = 0; idx < points_.size(); ++idx)
+      if (Gudhi::Euclidean_distance()(p, points_[idx]) <= radius)
+        *it++ = idx;
+  }
+
+ private:
+  const Vector_of_points& points_;
+};
+
+BOOST_AUTO_TEST_CASE(Rips_complex_tiles_and_neighbor_search) {
+  // ----------------------------------------------------------------------------
+  // Init of a random list of points, large enough to be cut in several tiles
+  // ----------------------------------------------------------------------------
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> coord(0., 1.);
+  Vector_of_points points;
+  for (int idx = 0; idx < 700; ++idx)
+    points.push_back(Point({coord(gen), coord(gen), coord(gen)}));
+  const double threshold = 0.1;
+  const int DIMENSION = 2;
+
+  std::cout << "========== Rips_complex_tiles_and_neighbor_search ==========" << std::endl;
+  // Euclidean_distance on std::vector<double> uses the vectorized tiles
+  Rips_complex rips_euclidean(points, threshold, Gudhi::Euclidean_distance());
+  Simplex_tree st_euclidean;
+  rips_euclidean.create_complex(st_euclidean, DIMENSION);
+
+  // Any other distance function uses the generic tiles
+  Rips_complex rips_generic(points, threshold, [](const Point& p1, const Point& p2) {
+    return Gudhi::Euclidean_distance()(p1, p2);
+  });
+  Simplex_tree st_generic;
+  rips_generic.create_complex(st_generic, DIMENSION);
+
+  Brute_force_neighbor_search neighbor_search(points);
+  Rips_complex rips_neighbors(points, threshold, Gudhi::Euclidean_distance(), neighbor_search);
+  Simplex_tree st_neighbors;
+  rips_neighbors.create_complex(st_neighbors, DIMENSION);
+
+  std::cout << "st_euclidean.num_simplices()=" << st_euclidean.num_simplices() << std::endl;
+  BOOST_CHECK(st_euclidean.num_vertices() == points.size());
+  BOOST_CHECK(st_euclidean.num_simplices() > points.size());
+  BOOST_CHECK(st_euclidean == st_generic);
+  BOOST_CHECK(st_euclidean == st_neighbors);
+
+  // The points of a range without random access are copied before the tiles are computed
+  std::list<Point> list_of_points(points.begin(), points.end());
+  Rips_complex rips_list(list_of_points, threshold, Gudhi::Euclidean_distance());
+  Simplex_tree st_list;
+  rips_list.create_complex(st_list, DIMENSION);
+  BOOST_CHECK(st_euclidean == st_list);
+
+  // Compare with the naive computation of all pairwise distances
+  std::size_t num_edges = 0;
+  for (std::size_t u = 0; u < points.size(); ++u)
+    for (std::size_t v = u + 1; v < points.size(); ++v)
+      if (Gudhi::Euclidean_distance()(points[u], points[v]) <= threshold)
+        ++num_edges;
+  std::size_t num_edges_in_complex = 0;
+  for (auto f_simplex : st_euclidean.skeleton_simplex_range(1)) {
+    if (st_euclidean.dimension(f_simplex) == 1) {
+      ++num_edges_in_complex;
+      std::vector<int> edge(st_euclidean.simplex_vertex_range(f_simplex).begin(),
+                            st_euclidean.simplex_vertex_range(f_simplex).end());
+      BOOST_CHECK(st_euclidean.filtration(f_simplex) ==
+                  Gudhi::Euclidean_distance()(points[edge[0]], points[edge[1]]));
+    }
+  }
+  BOOST_CHECK(num_edges_in_complex == num_edges);
+}
+
+BOOST_AUTO_TEST_CASE(Rips_complex_edge_collapse) {
+  // Noisy circle, with a few outliers
+  std::mt19937 gen(13);
+  std::uniform_real_distribution<double> angle(0., 2. * 3.14159265358979);
+  std::uniform_real_distribution<double> noise(-0.1, 0.1);
+  std::vector<Point> points;
+  for (int i = 0; i < 60; ++i) {
+    double a = angle(gen);
+    points.push_back({std::cos(a) + noise(gen), std::sin(a) + noise(gen)});
+  }
+  for (int i = 0; i < 10; ++i)
+    points.push_back({noise(gen) * 10, noise(gen) * 10});
+
+  const int DIMENSION = 3;
+  const Filtration_value threshold = 0.8;
+  Rips_complex rips(points, threshold, Gudhi::Euclidean_distance());
+  Simplex_tree st;
+  rips.create_complex(st, DIMENSION);
+
+  rips.collapse_edges();
+  Simplex_tree st_collapsed;
+  rips.create_complex(st_collapsed, DIMENSION);
+  std::cout << "st.num_simplices()=" << st.num_simplices() << " - st_collapsed.num_simplices()="
+      << st_collapsed.num_simplices() << std::endl;
+  BOOST_CHECK(st_collapsed.num_vertices() == points.size());
+  BOOST_CHECK(st_collapsed.num_simplices() < st.num_simplices());
+
+  using Persistent_cohomology = Gudhi::persistent_cohomology::Persistent_cohomology<Simplex_tree,
+      Gudhi::persistent_cohomology::Field_Zp>;
+  st.initialize_filtration();
+  Persistent_cohomology pcoh(st);
+  pcoh.init_coefficients(2);
+  pcoh.compute_persistent_cohomology();
+  st_collapsed.initialize_filtration();
+  Persistent_cohomology pcoh_collapsed(st_collapsed);
+  pcoh_collapsed.init_coefficients(2);
+  pcoh_collapsed.compute_persistent_cohomology();
+
+  // Same persistence in dimension less than DIMENSION
+  for (int dim = 0; dim < DIMENSION; ++dim) {
+    auto intervals = pcoh.intervals_in_dimension(dim);
+    auto intervals_collapsed = pcoh_collapsed.intervals_in_dimension(dim);
+    std::sort(intervals.begin(), intervals.end());
+    std::sort(intervals_collapsed.begin(), intervals_collapsed.end());
+    std::cout << "Dimension " << dim << " - " << intervals.size() << " intervals" << std::endl;
+    BOOST_CHECK(intervals == intervals_collapsed);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Implicit_rips_persistence_from_points) {
+  // Noisy sphere
+  std::mt19937 gen(5);
+  std::normal_distribution<double> normal(0., 1.);
+  std::uniform_real_distribution<double> noise(-0.05, 0.05);
+  std::vector<Point> points;
+  for (int i = 0; i < 50; ++i) {
+    Point p = {normal(gen), normal(gen), normal(gen)};
+    double norm = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+    for (double& x : p)
+      x = x / norm + noise(gen);
+    points.push_back(p);
+  }
+
+  const int DIMENSION = 3;
+  const Filtration_value threshold = 1.6;
+  Rips_complex rips(points, threshold, Gudhi::Euclidean_distance());
+  Simplex_tree st;
+  rips.create_complex(st, DIMENSION);
+  st.initialize_filtration();
+
+  using Persistent_cohomology = Gudhi::persistent_cohomology::Persistent_cohomology<Simplex_tree,
+      Gudhi::persistent_cohomology::Field_Zp>;
+  using Implicit_rips_persistence = Gudhi::rips_complex::Implicit_rips_persistence<Filtration_value>;
+  Implicit_rips_persistence implicit_rips(points, threshold, Gudhi::Euclidean_distance());
+  for (int p : {2, 3}) {
+    Persistent_cohomology pcoh(st);
+    pcoh.init_coefficients(p);
+    pcoh.compute_persistent_cohomology();
+    implicit_rips.init_coefficients(p);
+    implicit_rips.compute_persistent_cohomology(DIMENSION);
+
+    for (int dim = 0; dim < DIMENSION; ++dim) {
+      auto intervals = pcoh.intervals_in_dimension(dim);
+      auto implicit_intervals = implicit_rips.intervals_in_dimension(dim);
+      std::sort(intervals.begin(), intervals.end());
+      std::sort(implicit_intervals.begin(), implicit_intervals.end());
+      std::cout << "Z/" << p << "Z - dimension " << dim << " - " << intervals.size() << " intervals" << std::endl;
+      BOOST_CHECK(intervals == implicit_intervals);
+    }
+    BOOST_CHECK(implicit_rips.betti_numbers() == pcoh.betti_numbers());
+  }
+  BOOST_CHECK(implicit_rips.intervals_in_dimension(DIMENSION).empty());
+}
+
+BOOST_AUTO_TEST_CASE(Implicit_rips_persistence_from_distance_matrix) {
+  // Square with a diagonal of length 1.5: the 1-cycle is born at 1. and dies at 1.5
+  Distance_matrix distances = {{}, {1.}, {1.5, 1.}, {1., 1.5, 1.}};
+  Gudhi::rips_complex::Implicit_rips_persistence<Filtration_value> implicit_rips(distances, 2.);
+  implicit_rips.init_coefficients(11);
+  implicit_rips.compute_persistent_cohomology(2);
+  auto intervals = implicit_rips.intervals_in_dimension(1);
+  BOOST_CHECK(intervals.size() == 1);
+  GUDHI_TEST_FLOAT_EQUALITY_CHECK(intervals[0].first, 1.);
+  GUDHI_TEST_FLOAT_EQUALITY_CHECK(intervals[0].second, 1.5);
+  BOOST_CHECK(implicit_rips.intervals_in_dimension(0).size() == 4);
+  BOOST_CHECK(implicit_rips.betti_number(0) == 1);
+  BOOST_CHECK(implicit_rips.betti_number(1) == 0);
+
+  BOOST_CHECK_THROW(implicit_rips.init_coefficients(4), std::invalid_argument);
+}
+
 #ifdef GUDHI_DEBUG
 BOOST_AUTO_TEST_CASE(Rips_create_complex_throw) {
   // ----------------------------------------------------------------------------
@@ -21,6 +21,7 @@
  */
 
 #include <gudhi/Rips_complex.h>
+#include <gudhi/Implicit_rips_persistence.h>
 #include <gudhi/distance_functions.h>
 #include <gudhi/Simplex_tree.h>
 #include <gudhi/Persistent_cohomology.h>
@@ -36,13 +37,15 @@
 using Simplex_tree = Gudhi::Simplex_tree<Gudhi::Simplex_tree_options_fast_persistence>;
 using Filtration_value = Simplex_tree::Filtration_value;
 using Rips_complex = Gudhi::rips_complex::Rips_complex<Filtration_value>;
+using Implicit_rips_persistence = Gudhi::rips_complex::Implicit_rips_persistence<Filtration_value>;
 using Field_Zp = Gudhi::persistent_cohomology::Field_Zp;
 using Persistent_cohomology = Gudhi::persistent_cohomology::Persistent_cohomology<Simplex_tree, Field_Zp>;
 using Point = std::vector<double>;
 using Points_off_reader = Gudhi::Points_off_reader<Point>;
 
 void program_options(int argc, char* argv[], std::string& off_file_points, std::string& filediag,
-                     Filtration_value& threshold, int& dim_max, int& p, Filtration_value& min_persistence);
+                     Filtration_value& threshold, int& dim_max, int& p, Filtration_value& min_persistence,
+                     bool& edge_collapse, bool& implicit);
 
 int main(int argc, char* argv[]) {
   std::string off_file_points;
@@ -51,11 +54,32 @@ int main(int argc, char* argv[]) {
   int dim_max;
   int p;
   Filtration_value min_persistence;
+  bool edge_collapse;
+  bool implicit;
 
-  program_options(argc, argv, off_file_points, filediag, threshold, dim_max, p, min_persistence);
+  program_options(argc, argv, off_file_points, filediag, threshold, dim_max, p, min_persistence, edge_collapse,
+                  implicit);
 
   Points_off_reader off_reader(off_file_points);
+  if (implicit) {
+    // Compute the persistence diagram without building the complex
+    Implicit_rips_persistence implicit_rips(off_reader.get_point_cloud(), threshold, Gudhi::Euclidean_distance());
+    implicit_rips.init_coefficients(p);
+    implicit_rips.compute_persistent_cohomology(dim_max, min_persistence);
+
+    if (filediag.empty()) {
+      implicit_rips.output_diagram();
+    } else {
+      std::ofstream out(filediag);
+      implicit_rips.output_diagram(out);
+      out.close();
+    }
+    return 0;
+  }
+
   Rips_complex rips_complex_from_file(off_reader.get_point_cloud(), threshold, Gudhi::Euclidean_distance());
+  if (edge_collapse)
+    rips_complex_from_file.collapse_edges();
 
   // Construct the Rips complex in a Simplex Tree
   Simplex_tree simplex_tree;
@@ -87,7 +111,8 @@ int main(int argc, char* argv[]) {
 }
 
 void program_options(int argc, char* argv[], std::string& off_file_points, std::string& filediag,
-                     Filtration_value& threshold, int& dim_max, int& p, Filtration_value& min_persistence) {
+                     Filtration_value& threshold, int& dim_max, int& p, Filtration_value& min_persistence,
+                     bool& edge_collapse, bool& implicit) {
   namespace po = boost::program_options;
   po::options_description hidden("Hidden options");
   hidden.add_options()("input-file", po::value<std::string>(&off_file_points),
@@ -106,7 +131,13 @@ void program_options(int argc, char* argv[], std::string& off_file_points, std::
       "Characteristic p of the coefficient field Z/pZ for computing homology.")(
       "min-persistence,m", po::value<Filtration_value>(&min_persistence),
       "Minimal lifetime of homology feature to be recorded. Default is 0. Enter a negative value to see zero length "
-      "intervals");
+      "intervals")(
+      "edge-collapse,c", po::bool_switch(&edge_collapse),
+      "Collapse the edges of the Rips graph before the expansion. The persistence diagram is unchanged in dimension "
+      "less than cpx-dimension, but the complex is much smaller.")(
+      "implicit,i", po::bool_switch(&implicit),
+      "Compute the persistence without building the Rips complex, by enumerating its simplices from the distance "
+      "matrix. Uses much less memory. edge-collapse is ignored with this option.");
 
   po::positional_options_description pos;
   pos.add("input-file", 1);
@@ -0,0 +1,114 @@
+/*    This file is part of the Gudhi Library. The Gudhi library
+ *    (Geometric Understanding in Higher Dimensions) is a generic C++
+ *    library for computational topology.
+ *
+ *    Author(s):       Gudhi contributors
+ *
+ *    Copyright (C) 2018 Inria
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gudhi/Rips_complex.h>
+#include <gudhi/distance_functions.h>
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Points_off_io.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cstdlib>  // for std::atof, std::atoi
+
+using Point = std::vector<double>;
+using Points_off_reader = Gudhi::Points_off_reader<Point>;
+
+/* Number of bytes used by the sets of siblings of a simplex tree and by their members, and number of sets of
+ * siblings.*/
+template<typename Simplex_tree>
+void rec_memory(Simplex_tree& st, typename Simplex_tree::Siblings * sib, std::size_t& bytes,
+                std::size_t& num_siblings) {
+  bytes += sizeof(typename Simplex_tree::Siblings) +
+      sib->members().capacity() * sizeof(typename Simplex_tree::Dictionary::value_type);
+  ++num_siblings;
+  for (auto sh = sib->members().begin(); sh != sib->members().end(); ++sh)
+    if (st.has_children(sh))
+      rec_memory(st, st.children(sh), bytes, num_siblings);
+}
+
+/* Builds the Rips complex of the points in a simplex tree with the options Options, and reports the memory used per
+ * simplex, and the time to build the tree and to sort the filtration. */
+template<typename Options>
+void benchmark_options(const std::string& name, const std::vector<Point>& points, double threshold, int dim_max) {
+  using Simplex_tree = Gudhi::Simplex_tree<Options>;
+  using Filtration_value = typename Simplex_tree::Filtration_value;
+  using Rips_complex = Gudhi::rips_complex::Rips_complex<Filtration_value>;
+  std::chrono::time_point<std::chrono::system_clock> start, end;
+
+  std::cout << name << ":\n";
+  Rips_complex rips_complex(points, threshold, Gudhi::Euclidean_distance());
+  Simplex_tree st;
+  start = std::chrono::system_clock::now();
+  rips_complex.create_complex(st, dim_max);
+  end = std::chrono::system_clock::now();
+  std::cout << "  Compute Rips complex in "
+      << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms.\n";
+
+  std::size_t num_simplices = st.num_simplices();
+  std::size_t bytes = 0;
+  std::size_t num_siblings = 0;
+  rec_memory(st, st.root(), bytes, num_siblings);
+  // With packed nodes, each set of siblings has a pointer in the pool
+  if (Gudhi::Simplex_tree_uses_packed_nodes<Options>::value)
+    bytes += num_siblings * sizeof(typename Simplex_tree::Siblings *);
+  std::cout << "  - number of simplices = " << num_simplices << std::endl;
+  std::cout << "  - size of a member    = " << sizeof(typename Simplex_tree::Dictionary::value_type) << " bytes\n";
+  std::cout << "  - memory per simplex  = " << static_cast<double>(bytes) / num_simplices << " bytes\n";
+
+  start = std::chrono::system_clock::now();
+  st.initialize_filtration();
+  end = std::chrono::system_clock::now();
+  std::cout << "  Order the simplices of the filtration in "
+      << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms.\n";
+
+  start = std::chrono::system_clock::now();
+  std::size_t num_boundaries = 0;
+  for (auto sh : st.filtration_simplex_range())
+    for (auto b_sh : st.boundary_simplex_range(sh))
+      num_boundaries += (b_sh != st.null_simplex());
+  end = std::chrono::system_clock::now();
+  std::cout << "  Traverse the " << num_boundaries << " boundaries in "
+      << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms.\n";
+}
+
+/* Memory used per simplex by a simplex tree with different options, on the Rips complex of a set of points. The
+ * default points sample a Klein bottle embedded in dimension 5.
+ *
+ * Usage: Simplex_tree_memory_benchmark [off_file threshold dim_max]
+ */
+int main(int argc, char * argv[]) {
+  std::string off_file_points = argc > 1 ? argv[1] : "Kl.off";
+  double threshold = argc > 2 ? std::atof(argv[2]) : 0.27;
+  int dim_max = argc > 3 ? std::atoi(argv[3]) : 3;
+
+  Points_off_reader off_reader(off_file_points);
+  std::vector<Point> points = off_reader.get_point_cloud();
+
+  benchmark_options<Gudhi::Simplex_tree_options_full_featured>("Simplex_tree_options_full_featured", points,
+                                                               threshold, dim_max);
+  benchmark_options<Gudhi::Simplex_tree_options_fast_persistence>("Simplex_tree_options_fast_persistence", points,
+                                                                  threshold, dim_max);
+  benchmark_options<Gudhi::Simplex_tree_options_packed>("Simplex_tree_options_packed", points, threshold, dim_max);
+  return 0;
+}
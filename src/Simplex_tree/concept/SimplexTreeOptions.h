@@ -39,5 +39,14 @@ struct SimplexTreeOptions {
   static const bool store_filtration;
   /// If true, the list of vertices present in the complex must always be 0, ..., num_vertices-1, without any hole.
   static constexpr bool contiguous_vertices;
+  /// Optional, false if not defined. If true, the sets of siblings of the tree and their members are allocated in an
+  /// arena owned by the tree, and all released at once when the tree is destroyed. It saves most of the calls to the
+  /// memory allocator when building and destroying large trees.
+  static const bool arena_allocation;
+  /// Optional, false if not defined. If true, a node refers to its children by a 32 bits index in a table of the sets
+  /// of siblings of its tree, instead of a pointer, which avoids the padding of the nodes when the other types are 32
+  /// bits. Each tree owns its table, so the limit of 2^32 sets of siblings applies to each tree separately. Moving
+  /// along the tree is slightly slower.
+  static const bool packed_nodes;
 };
 
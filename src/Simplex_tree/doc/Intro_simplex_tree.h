@@ -48,6 +48,24 @@ namespace Gudhi {
  * is described in \cite boissonnatmariasimplextreealgorithmica
  * \image html "Simplex_tree_representation.png" "Simplex tree representation"
  * 
+ * Many simplices, e.g. the maximal cells of a triangulation, are inserted much faster all at once by
+ * `Simplex_tree::insert_simplices_and_subfaces()` than one by one: each set of siblings is built from the sorted list
+ * of its members, and the subtrees of the vertices are built in parallel.
+ *
+ * The memory used by the nodes of the tree depends on its options. With `Simplex_tree_options_packed`, a node takes
+ * 16 bytes, i.e. about 23 bytes per simplex with the sets of siblings, instead of 32 with
+ * `Simplex_tree_options_full_featured` (38 bytes per simplex). The benchmark `Simplex_tree_memory_benchmark` reports it
+ * on a Rips complex.
+ *
+ * A simplex tree can be saved in a compact binary format with `Simplex_tree::serialize()` or
+ * `write_simplex_tree_binary_file()`. Loading it back with `Simplex_tree::deserialize()` or
+ * `read_simplex_tree_binary_file()` builds the sets of siblings directly, without any search, from a read-only memory
+ * mapping of the file, which is much faster than reading the text format of `operator>>`.
+ *
+ * When the complex is only built to compute its persistence, `Simplex_tree::freeze()` copies it in a
+ * `Frozen_simplex_tree`, which stores the boundaries of the simplices explicitly in the order of the filtration. It is
+ * smaller than the simplex tree, and much faster to iterate for `Persistent_cohomology`.
+ *
  * \subsubsection filteredcomplexessimplextreeexamples Examples
  * 
  * Here is a list of simplex tree examples :
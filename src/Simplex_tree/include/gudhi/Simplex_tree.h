@@ -24,12 +24,19 @@
 #define SIMPLEX_TREE_H_
 
 #include <gudhi/Simplex_tree/Simplex_tree_node_explicit_storage.h>
+#include <gudhi/Simplex_tree/Simplex_tree_node_packed_storage.h>
 #include <gudhi/Simplex_tree/Simplex_tree_siblings.h>
+#include <gudhi/Simplex_tree/Simplex_tree_arena.h>
+#include <gudhi/Simplex_tree/serialization_utils.h>
+#include <gudhi/Simplex_tree/Simplex_tree_boundary_keys.h>
+#include <gudhi/Simplex_tree/Simplex_tree_filtration_sort.h>
+#include <gudhi/Simplex_tree/Frozen_simplex_tree.h>
 #include <gudhi/Simplex_tree/Simplex_tree_iterators.h>
 #include <gudhi/Simplex_tree/indexing_tag.h>
 
 #include <gudhi/reader_utils.h>
 #include <gudhi/graph_simplicial_complex.h>
+#include <gudhi/One_skeleton_csr_graph.h>
 #include <gudhi/Debug_utils.h>
 
 #include <boost/container/flat_map.hpp>
@@ -39,9 +46,14 @@
 
 #ifdef GUDHI_USE_TBB
 #include <tbb/parallel_sort.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/blocked_range.h>
 #endif
 
 #include <utility>
+#include <type_traits>  // for std::integral_constant
 #include <vector>
 #include <functional>  // for greater<>
 #include <stdexcept>
@@ -50,6 +62,9 @@
 #include <algorithm>  // for std::max
 #include <cstdint>  // for std::uint32_t
 #include <iterator>  // for std::distance
+#include <memory>  // for std::unique_ptr
+#include <cstring>  // for std::memcmp
+#include <ostream>
 
 namespace Gudhi {
 
@@ -87,16 +102,24 @@ class Simplex_tree {
   typedef typename Options::Vertex_handle Vertex_handle;
 
   /* Type of node in the simplex tree. */
-  typedef Simplex_tree_node_explicit_storage<Simplex_tree> Node;
+  // With the packed_nodes option, the node refers to its children by a 32 bits index instead of a pointer.
+  typedef typename std::conditional<Simplex_tree_uses_packed_nodes<Options>::value,
+      Simplex_tree_node_packed_storage<Simplex_tree>,
+      Simplex_tree_node_explicit_storage<Simplex_tree>>::type Node;
   /* Type of dictionary Vertex_handle -> Node for traversing the simplex tree. */
-  // Note: this wastes space when Vertex_handle is 32 bits and Node is aligned on 64 bits. It would be better to use a
-  // flat_set (with our own comparator) where we can control the layout of the struct (put Vertex_handle and
-  // Simplex_key next to each other).
-  typedef typename boost::container::flat_map<Vertex_handle, Node> Dictionary;
+  // Note: this wastes space when Vertex_handle is 32 bits and Node is aligned on 64 bits, which the packed_nodes
+  // option avoids.
+  // With the arena_allocation option, the members of the siblings are allocated in the arena of the tree.
+  typedef typename std::conditional<Simplex_tree_uses_arena<Options>::value,
+      boost::container::flat_map<Vertex_handle, Node, std::less<Vertex_handle>,
+                                 Simplex_tree_arena_allocator<std::pair<Vertex_handle, Node>>>,
+      boost::container::flat_map<Vertex_handle, Node>>::type Dictionary;
 
-  /* \brief Set of nodes sharing a same parent in the simplex tree. */
   /* \brief Set of nodes sharing a same parent in the simplex tree. */
   typedef Simplex_tree_siblings<Simplex_tree, Dictionary> Siblings;
+  /* \brief Table of the sets of siblings of the tree, to which the packed nodes refer by index.*/
+  typedef typename std::conditional<Simplex_tree_uses_packed_nodes<Options>::value,
+      Simplex_tree_siblings_pool<Siblings>, Simplex_tree_no_siblings_pool>::type Siblings_pool;
 
   struct Key_simplex_base_real {
     Key_simplex_base_real() : key_(-1) {}
@@ -175,6 +198,10 @@ class Simplex_tree {
   typedef boost::iterator_range<Boundary_simplex_iterator> Boundary_simplex_range;
   /** \brief Range over the simplices of the boundary of a simplex, with coefficients. */
   typedef Simplex_tree_oriented_boundary_range<Simplex_tree> Boundary_oriented_simplex_range;
+  /** \brief Range over the keys of the simplices of the boundary of a simplex, stored contiguously.
+   *
+   * Random access range. */
+  typedef typename Simplex_tree_boundary_keys<Simplex_key>::Range Boundary_key_range;
   /** \brief Iterator over the simplices of the simplicial complex.
    *
    * 'value_type' is Simplex_handle. */
@@ -301,6 +328,22 @@ class Simplex_tree {
     return Boundary_oriented_simplex_range(this, sh);
   }
 
+  /** \brief Returns the keys of the simplices of the boundary of a simplex, from the cache computed by
+   * `initialize_boundary_keys()`.
+   *
+   * The keys are in the order of `boundary_oriented_simplex_range()`, whose coefficients alternate starting with
+   * \f$(-1)^d\f$ for a simplex of dimension \f$d\f$. Reading the cache is a linear scan, and can be done
+   * concurrently.
+   *
+   * \pre `initialize_boundary_keys()` has been called, and neither the complex nor the keys have been modified since.
+   *
+   * @param[in] sh Simplex for which the boundary is returned. */
+  Boundary_key_range boundary_key_range(Simplex_handle sh) const {
+    GUDHI_CHECK(key(sh) < boundary_keys_.num_simplices(),
+                std::logic_error("Simplex_tree::boundary_key_range - the boundary keys are not initialized"));
+    return boundary_keys_.range(key(sh));
+  }
+
   /** @} */  // end range and iterator methods
   /** \name Constructor/Destructor
    * @{ */
@@ -308,30 +351,38 @@ class Simplex_tree {
   /** \brief Constructs an empty simplex tree. */
   Simplex_tree()
       : null_vertex_(-1),
-      root_(nullptr, null_vertex_),
+      pool_(make_pool()),
+      root_(pool_.get(), null_vertex_),
       filtration_vect_(),
-      dimension_(-1) { }
+      dimension_(-1),
+      arena_(make_arena()) { }
 
   /** \brief User-defined copy constructor reproduces the whole tree structure. */
   Simplex_tree(const Simplex_tree& simplex_source)
       : null_vertex_(simplex_source.null_vertex_),
-      root_(nullptr, null_vertex_ , simplex_source.root_.members_),
+      pool_(make_pool()),
+      root_(pool_.get(), null_vertex_),
       filtration_vect_(),
-      dimension_(simplex_source.dimension_) {
-    auto root_source = simplex_source.root_;
-    rec_copy(&root_, &root_source);
+      dimension_(simplex_source.dimension_),
+      arena_(make_arena()) {
+    root_.members_ = simplex_source.root_.members_;
+    for (auto& map_el : root_.members_)
+      map_el.second.assign_children(&root_);
+    rec_copy(&root_, &simplex_source.root_);
   }
 
   /** \brief depth first search, inserts simplices when reaching a leaf. */
-  void rec_copy(Siblings *sib, Siblings *sib_source) {
-    for (auto sh = sib->members().begin(), sh_source = sib_source->members().begin();
-         sh != sib->members().end(); ++sh, ++sh_source) {
-      if (has_children(sh_source)) {
-        Siblings * newsib = new Siblings(sib, sh_source->first);
-        newsib->members_.reserve(sh_source->second.children()->members().size());
-        for (auto & child : sh_source->second.children()->members())
+  void rec_copy(Siblings *sib, const Siblings *sib_source) {
+    auto sh_source = sib_source->members_.begin();
+    for (auto sh = sib->members().begin(); sh != sib->members().end(); ++sh, ++sh_source) {
+      // The nodes of the source refer to the pool of siblings of the source tree.
+      Siblings * children_source = sh_source->second.children(sib_source->pool());
+      if (children_source->parent() == sh_source->first) {
+        Siblings * newsib = new_siblings(sib, sh_source->first);
+        newsib->members_.reserve(children_source->members().size());
+        for (auto & child : children_source->members())
           newsib->members_.emplace_hint(newsib->members_.end(), child.first, Node(newsib, child.second.filtration()));
-        rec_copy(newsib, sh_source->second.children());
+        rec_copy(newsib, children_source);
         sh->second.assign_children(newsib);
       }
     }
@@ -340,18 +391,34 @@ class Simplex_tree {
   /** \brief User-defined move constructor moves the whole tree structure. */
   Simplex_tree(Simplex_tree && old)
       : null_vertex_(std::move(old.null_vertex_)),
+      pool_(std::move(old.pool_)),
       root_(std::move(old.root_)),
       filtration_vect_(std::move(old.filtration_vect_)),
-      dimension_(std::move(old.dimension_)) {
+      boundary_keys_(std::move(old.boundary_keys_)),
+      dimension_(std::move(old.dimension_)),
+      arena_(std::move(old.arena_)) {
+    // The leaves of the root and the children of its members still refer to the old root.
+    for (auto sh = root_.members().begin(); sh != root_.members().end(); ++sh) {
+      if (has_children(sh))
+        children(sh)->oncles_ = &root_;
+      else
+        sh->second.assign_children(&root_);
+    }
     old.dimension_ = -1;
-    old.root_ = Siblings(nullptr, null_vertex_);
+    old.boundary_keys_.clear();
+    old.pool_ = old.make_pool();
+    old.root_ = Siblings(old.pool_.get(), null_vertex_);
+    old.arena_ = old.make_arena();
   }
 
   /** \brief Destructor; deallocates the whole tree structure. */
   ~Simplex_tree() {
+    // With the arena_allocation option, the siblings are released all at once with the arena. With the packed_nodes
+    // option, their indices are released with the pool of siblings of the tree.
+    if (arena_) return;
     for (auto sh = root_.members().begin(); sh != root_.members().end(); ++sh) {
       if (has_children(sh)) {
-        rec_delete(sh->second.children());
+        rec_delete(children(sh));
       }
     }
   }
@@ -361,10 +428,56 @@ class Simplex_tree {
   void rec_delete(Siblings * sib) {
     for (auto sh = sib->members().begin(); sh != sib->members().end(); ++sh) {
       if (has_children(sh)) {
-        rec_delete(sh->second.children());
+        rec_delete(children(sh));
       }
     }
-    delete sib;
+    delete_siblings(sib);
+  }
+
+  /* Returns a new pool of siblings if the tree has packed nodes, nullptr otherwise. */
+  static std::unique_ptr<Siblings_pool> make_pool() {
+    return std::unique_ptr<Siblings_pool>(Simplex_tree_uses_packed_nodes<Options>::value ? new Siblings_pool
+                                                                                         : nullptr);
+  }
+
+  /* Returns a new arena if the tree allocates its siblings in one, nullptr otherwise. */
+  static std::unique_ptr<Simplex_tree_arena> make_arena() {
+    return std::unique_ptr<Simplex_tree_arena>(Simplex_tree_uses_arena<Options>::value ? new Simplex_tree_arena
+                                                                                     : nullptr);
+  }
+
+  /* Allocates a set of siblings, in the arena if there is one. The arguments are forwarded to the constructor of
+   * Siblings. Safe to call from parallel tasks. */
+  template<class... Args>
+  Siblings* new_siblings(Args&&... args) {
+    return new_siblings(std::integral_constant<bool, Simplex_tree_uses_arena<Options>::value>(),
+                        std::forward<Args>(args)...);
+  }
+
+  template<class... Args>
+  Siblings* new_siblings(std::false_type, Args&&... args) {
+    return new Siblings(std::forward<Args>(args)...);
+  }
+
+  template<class... Args>
+  Siblings* new_siblings(std::true_type, Args&&... args) {
+    void* memory = arena_->allocate(sizeof(Siblings));
+    try {
+      return new (memory) Siblings(std::forward<Args>(args)..., typename Dictionary::allocator_type(arena_.get()));
+    } catch (...) {
+      arena_->deallocate(memory, sizeof(Siblings));
+      throw;
+    }
+  }
+
+  /* Deallocates a set of siblings allocated by new_siblings. */
+  void delete_siblings(Siblings* sib) {
+    if (arena_) {
+      sib->~Siblings();
+      arena_->deallocate(sib, sizeof(Siblings));
+    } else {
+      delete sib;
+    }
   }
 
  public:
@@ -373,7 +486,7 @@ class Simplex_tree {
     if ((null_vertex_ != st2.null_vertex_) ||
         (dimension_ != st2.dimension_))
       return false;
-    return rec_equal(&root_, &st2.root_);
+    return rec_equal(&root_, st2, &st2.root_);
   }
 
   /** \brief Checks if two simplex trees are different. */
@@ -382,19 +495,20 @@ class Simplex_tree {
   }
 
  private:
-  /** rec_equal: Checks recursively whether or not two simplex trees are equal, using depth first search. */
-  bool rec_equal(Siblings* s1, Siblings* s2) {
+  /** rec_equal: Checks recursively whether or not two simplex trees are equal, using depth first search.
+   * The children of s2 are reached through st2, which owns them. */
+  bool rec_equal(Siblings* s1, const Simplex_tree& st2, Siblings* s2) {
     if (s1->members().size() != s2->members().size())
       return false;
     for (auto sh1 = s1->members().begin(), sh2 = s2->members().begin();
          (sh1 != s1->members().end() && sh2 != s2->members().end()); ++sh1, ++sh2) {
       if (sh1->first != sh2->first || sh1->second.filtration() != sh2->second.filtration())
         return false;
-      if (has_children(sh1) != has_children(sh2))
+      if (has_children(sh1) != st2.has_children(sh2))
         return false;
       // Recursivity on children only if both have children
       else if (has_children(sh1))
-        if (!rec_equal(sh1->second.children(), sh2->second.children()))
+        if (!rec_equal(children(sh1), st2, st2.children(sh2)))
           return false;
     }
     return true;
@@ -480,7 +594,7 @@ class Simplex_tree {
     size_t simplices_number = sib_end - sib_begin;
     for (auto sh = sib_begin; sh != sib_end; ++sh) {
       if (has_children(sh)) {
-        simplices_number += num_simplices(sh->second.children());
+        simplices_number += num_simplices(children(sh));
       }
     }
     return simplices_number;
@@ -520,7 +634,14 @@ class Simplex_tree {
   template<class SimplexHandle>
   bool has_children(SimplexHandle sh) const {
     // Here we rely on the root using null_vertex(), which cannot match any real vertex.
-    return (sh->second.children()->parent() == sh->first);
+    return (children(sh)->parent() == sh->first);
+  }
+
+  /** \brief Returns the set of siblings of the children of the node in the simplex tree pointed by sh if it has
+   * children, and the set of siblings of the node itself otherwise.*/
+  template<class SimplexHandle>
+  Siblings* children(SimplexHandle sh) const {
+    return sh->second.children(pool_.get());
   }
 
     /** \brief Given a range of Vertex_handles, returns the Simplex_handle
@@ -561,7 +682,7 @@ class Simplex_tree {
         return tmp_dit;
       if (!has_children(tmp_dit))
         return null_simplex();
-      tmp_sib = tmp_dit->second.children();
+      tmp_sib = children(tmp_dit);
     }
     for (;;) {
       tmp_dit = tmp_sib->members_.find(*vi++);
@@ -571,7 +692,7 @@ class Simplex_tree {
         return tmp_dit;
       if (!has_children(tmp_dit))
         return null_simplex();
-      tmp_sib = tmp_dit->second.children();
+      tmp_sib = children(tmp_dit);
     }
   }
 
@@ -619,9 +740,9 @@ class Simplex_tree {
       GUDHI_CHECK(*vi != null_vertex(), "cannot use the dummy null_vertex() as a real vertex");
       res_insert = curr_sib->members_.emplace(*vi, Node(curr_sib, filtration));
       if (!(has_children(res_insert.first))) {
-        res_insert.first->second.assign_children(new Siblings(curr_sib, *vi));
+        res_insert.first->second.assign_children(new_siblings(curr_sib, *vi));
       }
-      curr_sib = res_insert.first->second.children();
+      curr_sib = children(res_insert.first);
     }
     GUDHI_CHECK(*vi != null_vertex(), "cannot use the dummy null_vertex() as a real vertex");
     res_insert = curr_sib->members_.emplace(*vi, Node(curr_sib, filtration));
@@ -718,6 +839,180 @@ class Simplex_tree {
     return insert_simplex_and_subfaces_sorted(copy, filtration);
   }
 
+  /** \brief Inserts a range of simplices and all their subfaces in the simplicial complex.
+   *
+   * The result is the same as calling `insert_simplex_and_subfaces()` on each simplex of the range, i.e. the
+   * filtration value of a simplex is the minimum of its previous value (if it was already there) and of the values
+   * of the inserted simplices that contain it, but it is much faster for large ranges. Each set of siblings is
+   * built at once from a sorted list of its new members, instead of inserting them one by one, and the subtrees of
+   * the different vertices are built in parallel if TBB is available.
+   *
+   * @param[in] simplices Range of simplices, each of them a range of Vertex_handles, which do not need to be sorted.
+   * @param[in] filtration The filtration value assigned to all the simplices.
+   */
+  template<class SimplexRange>
+  void insert_simplices_and_subfaces(const SimplexRange& simplices, Filtration_value filtration = 0) {
+    Bulk_insertion input;
+    for (auto&& simplex : simplices)
+      input.add_simplex(simplex, filtration);
+    bulk_insert(input);
+  }
+
+  /** \brief Inserts a range of simplices and all their subfaces in the simplicial complex, with a filtration value
+   * for each simplex.
+   *
+   * Same as the previous function, except that the filtration value of the i-th simplex of `simplices` is the i-th
+   * element of `filtrations`, which must have at least as many elements.
+   */
+  template<class SimplexRange, class FiltrationRange,
+           class = typename std::enable_if<!std::is_convertible<FiltrationRange, Filtration_value>::value>::type>
+  void insert_simplices_and_subfaces(const SimplexRange& simplices, const FiltrationRange& filtrations) {
+    Bulk_insertion input;
+    auto filtration = std::begin(filtrations);
+    for (auto&& simplex : simplices)
+      input.add_simplex(simplex, *filtration++);
+    bulk_insert(input);
+  }
+
+ private:
+  /* The sorted vertices of the simplices given to insert_simplices_and_subfaces, stored contiguously.*/
+  struct Bulk_insertion {
+    template<class VertexRange>
+    void add_simplex(const VertexRange& simplex, Filtration_value filtration) {
+      auto first = vertices.insert(vertices.end(), std::begin(simplex), std::end(simplex));
+      if (first == vertices.end()) return;
+      std::sort(first, vertices.end());
+      GUDHI_CHECK(std::adjacent_find(first, vertices.end()) == vertices.end(), "repeated vertex in a simplex");
+      ends.push_back(vertices.size());
+      filtrations.push_back(filtration);
+    }
+
+    std::vector<Vertex_handle> vertices;
+    std::vector<std::size_t> ends;
+    std::vector<Filtration_value> filtrations;
+  };
+
+  /* A member of a set of siblings under construction, coming from the simplex number simplex of a Bulk_insertion.
+   * Its children come from the vertices of the simplex after position.*/
+  struct Bulk_insertion_entry {
+    Vertex_handle vertex;
+    std::size_t simplex;
+    std::size_t position;
+  };
+
+  /* Buffers for one level of the tree, reused by all the sets of siblings at this depth.*/
+  struct Bulk_insertion_level {
+    std::vector<Bulk_insertion_entry> entries;
+    std::vector<std::pair<Vertex_handle, Node>> members;
+  };
+  typedef std::vector<Bulk_insertion_level> Bulk_insertion_levels;
+
+  void bulk_insert(const Bulk_insertion& input) {
+    if (input.ends.empty()) return;
+    std::vector<Bulk_insertion_entry> simplices;
+    simplices.reserve(input.ends.size());
+    std::size_t begin = 0;
+    std::size_t max_size = 0;
+    for (std::size_t i = 0; i < input.ends.size(); ++i) {
+      GUDHI_CHECK_code(
+        for (std::size_t position = begin; position < input.ends[i]; ++position)
+          GUDHI_CHECK(input.vertices[position] != null_vertex(), "cannot use the dummy null_vertex() as a real vertex");
+      )
+      max_size = (std::max)(max_size, input.ends[i] - begin);
+      simplices.push_back({null_vertex(), i, begin});
+      begin = input.ends[i];
+    }
+    dimension_ = (std::max)(dimension_, static_cast<int>(max_size) - 1);
+
+    // The root is built serially, then the subtrees of its members are independent.
+    std::vector<std::pair<Simplex_handle, std::pair<std::size_t, std::size_t>>> subtrees;
+    Bulk_insertion_level root_level;
+    bulk_insert_siblings(&root_, input, simplices.data(), simplices.data() + simplices.size(), root_level,
+                         [&subtrees](Simplex_handle sh, std::size_t first, std::size_t last) {
+                           subtrees.emplace_back(sh, std::make_pair(first, last));
+                         });
+    const Bulk_insertion_entry* root_entries = root_level.entries.data();
+    auto insert_subtree = [&](std::size_t i, Bulk_insertion_levels& levels) {
+      // Allocated before the recursion, which keeps references to the levels.
+      if (levels.size() < max_size) levels.resize(max_size);
+      Simplex_handle sh = subtrees[i].first;
+      if (!has_children(sh))
+        sh->second.assign_children(new_siblings(&root_, sh->first));
+      rec_bulk_insert(children(sh), input, root_entries + subtrees[i].second.first,
+                      root_entries + subtrees[i].second.second, levels, 0);
+    };
+#ifdef GUDHI_USE_TBB
+    tbb::enumerable_thread_specific<Bulk_insertion_levels> thread_levels;
+    tbb::parallel_for(std::size_t(0), subtrees.size(), [&](std::size_t i) {
+      insert_subtree(i, thread_levels.local());
+    });
+#else
+    Bulk_insertion_levels levels;
+    for (std::size_t i = 0; i < subtrees.size(); ++i)
+      insert_subtree(i, levels);
+#endif
+  }
+
+  void rec_bulk_insert(Siblings* sib, const Bulk_insertion& input, const Bulk_insertion_entry* first,
+                       const Bulk_insertion_entry* last, Bulk_insertion_levels& levels, std::size_t depth) {
+    Bulk_insertion_level& level = levels[depth];
+    bulk_insert_siblings(sib, input, first, last, level,
+                         [&](Simplex_handle sh, std::size_t child_first, std::size_t child_last) {
+                           if (!has_children(sh))
+                             sh->second.assign_children(new_siblings(sib, sh->first));
+                           // The entries of this level are not modified by the deeper levels.
+                           const Bulk_insertion_entry* entries = level.entries.data();
+                           rec_bulk_insert(children(sh), input, entries + child_first,
+                                           entries + child_last, levels, depth + 1);
+                         });
+  }
+
+  /* Inserts in sib the first vertex of each of the tails of simplices [first, last), and of all their suffixes: to
+   * insert {1,2,3} we insert 1, 2 and 3 in sib, with children {2,3} below 1 and {3} below 2. Calls
+   * insert_children(sh, child_first, child_last) for each member sh of sib with children, which are the tails in
+   * [child_first, child_last) of level.entries.*/
+  template<class InsertChildren>
+  void bulk_insert_siblings(Siblings* sib, const Bulk_insertion& input, const Bulk_insertion_entry* first,
+                            const Bulk_insertion_entry* last, Bulk_insertion_level& level,
+                            InsertChildren&& insert_children) {
+    std::vector<Bulk_insertion_entry>& entries = level.entries;
+    entries.clear();
+    for (; first != last; ++first)
+      for (std::size_t position = first->position; position < input.ends[first->simplex]; ++position)
+        entries.push_back({input.vertices[position], first->simplex, position + 1});
+    std::sort(entries.begin(), entries.end(),
+              [](const Bulk_insertion_entry& e1, const Bulk_insertion_entry& e2) { return e1.vertex < e2.vertex; });
+
+    // One member per vertex, with the smallest filtration value
+    std::vector<std::pair<Vertex_handle, Node>>& members = level.members;
+    members.clear();
+    for (auto entry = entries.begin(); entry != entries.end();) {
+      Vertex_handle vertex = entry->vertex;
+      Filtration_value filt = input.filtrations[entry->simplex];
+      for (++entry; entry != entries.end() && entry->vertex == vertex; ++entry)
+        if (input.filtrations[entry->simplex] < filt) filt = input.filtrations[entry->simplex];
+      members.emplace_back(vertex, Node(sib, filt));
+    }
+    Dictionary& dict = sib->members();
+    dict.insert(boost::container::ordered_unique_range, members.begin(), members.end());
+
+    // The members that were already there keep their children, and the smallest filtration value.
+    Simplex_handle sh = dict.begin();
+    std::size_t entry = 0;
+    for (auto const& member : members) {
+      while (sh->first != member.first) ++sh;
+      if (member.second.filtration() < filtration(sh))
+        assign_filtration(sh, member.second.filtration());
+      // Keeps the tails of the group of entries of this member that are not empty, and moves them to its beginning.
+      std::size_t child_first = entry;
+      std::size_t child_last = entry;
+      for (; entry < entries.size() && entries[entry].vertex == member.first; ++entry)
+        if (entries[entry].position < input.ends[entries[entry].simplex])
+          entries[child_last++] = entries[entry];
+      if (child_first != child_last) insert_children(sh, child_first, child_last);
+    }
+  }
+
  private:
   /// Same as insert_simplex_and_subfaces but assumes that the range of vertices is sorted
   template<class ForwardVertexRange = std::initializer_list<Vertex_handle>>
@@ -754,8 +1049,8 @@ class Simplex_tree {
     if (++first == last) return insertion_result;
     if (!has_children(simplex_one))
       // TODO: have special code here, we know we are building the whole subtree from scratch.
-      simplex_one->second.assign_children(new Siblings(sib, vertex_one));
-    auto res = rec_insert_simplex_and_subfaces_sorted(simplex_one->second.children(), first, last, filt);
+      simplex_one->second.assign_children(new_siblings(sib, vertex_one));
+    auto res = rec_insert_simplex_and_subfaces_sorted(children(simplex_one), first, last, filt);
     // No need to continue if the full simplex was already there with a low enough filtration value.
     if (res.first != null_simplex()) rec_insert_simplex_and_subfaces_sorted(sib, first, last, filt);
     return res;
@@ -779,10 +1074,10 @@ class Simplex_tree {
   /** Returns the Siblings containing a simplex.*/
   template<class SimplexHandle>
   Siblings* self_siblings(SimplexHandle sh) {
-    if (sh->second.children()->parent() == sh->first)
-      return sh->second.children()->oncles();
+    if (children(sh)->parent() == sh->first)
+      return children(sh)->oncles();
     else
-      return sh->second.children();
+      return children(sh);
   }
 
  public:
@@ -808,28 +1103,54 @@ class Simplex_tree {
    * assigned a Simplex_key corresponding to its order in the filtration (from 0 to m-1 for a
    * simplicial complex with m simplices).
    *
+   * The simplices with the same filtration value are ordered by reverse lexicographic order on their vertices, which
+   * puts the faces before their cofaces. The sort is a radix sort when `Filtration_value` is `float` or `double`.
+   *
    * Will be automatically called when calling filtration_simplex_range()
    * if the filtration has never been initialized yet. */
   void initialize_filtration() {
-    filtration_vect_.clear();
-    filtration_vect_.reserve(num_simplices());
-    for (Simplex_handle sh : complex_simplex_range())
-      filtration_vect_.push_back(sh);
-
-    /* We use stable_sort here because with libstdc++ it is faster than sort.
-     * is_before_in_filtration is now a total order, but we used to call
-     * stable_sort for the following heuristic:
-     * The use of a depth-first traversal of the simplex tree, provided by
-     * complex_simplex_range(), combined with a stable sort is meant to
-     * optimize the order of simplices with same filtration value. The
-     * heuristic consists in inserting the cofaces of a simplex as soon as
-     * possible.
-     */
-#ifdef GUDHI_USE_TBB
-    tbb::parallel_sort(filtration_vect_.begin(), filtration_vect_.end(), is_before_in_filtration(this));
-#else
-    std::stable_sort(filtration_vect_.begin(), filtration_vect_.end(), is_before_in_filtration(this));
-#endif
+    boundary_keys_.clear();
+    // Lists the simplices in reverse lexicographic order, which breaks the ties, then sorts them stably by filtration
+    // value, without any tree walk in the comparisons.
+    reverse_lexicographic_simplices(filtration_vect_);
+    sort_by_filtration(std::integral_constant<bool, Filtration_radix_key<Filtration_value>::is_specialized>());
+  }
+
+  /** \brief Computes the keys of the boundaries of all the simplices, for `boundary_key_range()`.
+   *
+   * Computes the filtration with `initialize_filtration()` if it has not been done yet, and sets the key of each
+   * simplex to its position in the filtration. The boundaries are then computed in one pass over the filtration, in
+   * parallel if TBB is available. The cache is cleared by `initialize_filtration()`, and must be recomputed after
+   * any modification of the complex.
+   */
+  void initialize_boundary_keys() {
+    static_assert(Options::store_key, "initialize_boundary_keys() needs Options::store_key");
+    // Initializes the filtration first, as it clears the boundary keys
+    Filtration_simplex_range const& filtration = filtration_simplex_range();
+    boundary_keys_.clear();
+    boundary_keys_.reserve(filtration.size());
+    Simplex_key position = 0;
+    for (Simplex_handle sh : filtration) {
+      assign_key(sh, position++);
+      int dim = dimension(sh);
+      boundary_keys_.add_simplex(dim == 0 ? 0 : dim + 1);
+    }
+    boundary_keys_.fill([this](Simplex_key position, typename std::vector<Simplex_key>::iterator output) {
+      for (auto b_sh : boundary_oriented_simplex_range(filtration_vect_[position]))
+        *output++ = key(b_sh.first);
+    });
+  }
+
+  /** \brief Returns a compact read-only copy of the filtered complex, for persistence computations.
+   *
+   * The `Frozen_simplex_tree` stores the simplices in the order of the filtration with their filtration values, keys
+   * and boundaries, but not their vertices. It can then be given to `Persistent_cohomology` instead of the simplex
+   * tree, which can be destroyed. Computes the filtration with `initialize_filtration()` if it has not been done yet,
+   * and sets the key of each simplex to its position in the filtration.
+   */
+  Frozen_simplex_tree<Options> freeze() {
+    static_assert(Options::store_key, "freeze() needs Options::store_key");
+    return Frozen_simplex_tree<Options>(*this);
   }
 
  private:
@@ -859,7 +1180,7 @@ class Simplex_tree {
         if (addCoface)
           cofaces.push_back(simplex);
         if ((!addCoface || star) && has_children(simplex))  // Rec call
-          rec_coface(vertices, simplex->second.children(), curr_nbVertices + 1, cofaces, star, nbVertices);
+          rec_coface(vertices, children(simplex), curr_nbVertices + 1, cofaces, star, nbVertices);
       } else {
         if (simplex->first == vertices.back()) {
           // If curr_sib matches with the top vertex
@@ -871,7 +1192,7 @@ class Simplex_tree {
             // Rec call
             Vertex_handle tmp = vertices.back();
             vertices.pop_back();
-            rec_coface(vertices, simplex->second.children(), curr_nbVertices + 1, cofaces, star, nbVertices);
+            rec_coface(vertices, children(simplex), curr_nbVertices + 1, cofaces, star, nbVertices);
             vertices.push_back(tmp);
           }
         } else if (simplex->first > vertices.back()) {
@@ -879,7 +1200,7 @@ class Simplex_tree {
         } else {
           // (simplex->first < vertices.back()
           if (has_children(simplex))
-            rec_coface(vertices, simplex->second.children(), curr_nbVertices + 1, cofaces, star, nbVertices);
+            rec_coface(vertices, children(simplex), curr_nbVertices + 1, cofaces, star, nbVertices);
         }
       }
     }
@@ -919,50 +1240,82 @@ class Simplex_tree {
   }
 
  private:
-  /** \brief Returns true iff the list of vertices of sh1
-   * is smaller than the list of vertices of sh2 w.r.t.
-   * lexicographic order on the lists read in reverse.
-   *
-   * It defines a StrictWeakOrdering on simplices. The Simplex_vertex_iterators
-   * must traverse the Vertex_handle in decreasing order. Reverse lexicographic order satisfy
-   * the property that a subsimplex of a simplex is always strictly smaller with this order. */
-  bool reverse_lexicographic_order(Simplex_handle sh1, Simplex_handle sh2) {
-    Simplex_vertex_range rg1 = simplex_vertex_range(sh1);
-    Simplex_vertex_range rg2 = simplex_vertex_range(sh2);
-    Simplex_vertex_iterator it1 = rg1.begin();
-    Simplex_vertex_iterator it2 = rg2.begin();
-    while (it1 != rg1.end() && it2 != rg2.end()) {
-      if (*it1 == *it2) {
-        ++it1;
-        ++it2;
-      } else {
-        return *it1 < *it2;
-      }
-    }
-    return ((it1 == rg1.end()) && (it2 != rg2.end()));
-  }
-
-  /** \brief StrictWeakOrdering, for the simplices, defined by the filtration.
+  /** \brief Lists all the simplices in reverse lexicographic order, i.e. the lexicographic order on the lists of
+   * vertices read in decreasing order.
    *
-   * It corresponds to the partial order
-   * induced by the filtration values, with ties resolved using reverse lexicographic order.
-   * Reverse lexicographic order has the property to always consider the subsimplex of a simplex
-   * to be smaller. The filtration function must be monotonic. */
-  struct is_before_in_filtration {
-    explicit is_before_in_filtration(Simplex_tree * st)
-        : st_(st) { }
-
-    bool operator()(const Simplex_handle sh1, const Simplex_handle sh2) const {
-      // Not using st_->filtration(sh1) because it uselessly tests for null_simplex.
-      if (sh1->second.filtration() != sh2->second.filtration()) {
-        return sh1->second.filtration() < sh2->second.filtration();
+   * It is a total order on simplices with the property that a subsimplex of a simplex is always strictly smaller.
+   * The simplices whose largest vertex is v come after the ones with a smaller largest vertex, and are ordered like
+   * their facets without v, i.e. like their parents in the tree. The simplices are thus bucketed by vertex: the
+   * buckets are processed by increasing vertex, and the children of each simplex are appended to their buckets in
+   * this order, which ranks every simplex after its parent in linear time, without comparing any vertex lists. */
+  void reverse_lexicographic_simplices(std::vector<Simplex_handle>& simplices) {
+    simplices.clear();
+    simplices.resize(num_simplices());
+    Dictionary& vertices = root_.members();
+    if (vertices.empty()) return;
+    // Position of a vertex in the root, which numbers the buckets. The vertices are often 0, ..., n-1.
+    const bool contiguous_vertices = vertices.rbegin()->first - vertices.begin()->first
+                                     == static_cast<Vertex_handle>(vertices.size() - 1);
+    auto bucket = [&](Vertex_handle v) -> std::size_t {
+      if (contiguous_vertices) return v - vertices.begin()->first;
+      return vertices.find(v) - vertices.begin();
+    };
+
+    // bucket_end[i] is first the size of the bucket i, then the position where its next simplex is stored.
+    std::vector<std::size_t> bucket_end(vertices.size() + 1, 0);
+    for (Simplex_handle sh : complex_simplex_range())
+      ++bucket_end[bucket(sh->first) + 1];
+    for (std::size_t i = 1; i < bucket_end.size(); ++i)
+      bucket_end[i] += bucket_end[i - 1];
+    std::vector<std::size_t> bucket_begin(bucket_end.begin(), bucket_end.end() - 1);
+    for (auto sh = vertices.begin(); sh != vertices.end(); ++sh)
+      simplices[bucket_end[sh - vertices.begin()]++] = sh;
+
+    // The buckets of the children are larger, so each bucket is complete when it is reached.
+    for (std::size_t i = 0; i < vertices.size(); ++i) {
+      for (std::size_t position = bucket_begin[i]; position < bucket_end[i]; ++position) {
+        Simplex_handle sh = simplices[position];
+        if (has_children(sh)) {
+          auto& members = children(sh)->members();
+          for (auto child = members.begin(); child != members.end(); ++child)
+            simplices[bucket_end[bucket(child->first)]++] = child;
+        }
       }
-      // is sh1 a proper subface of sh2
-      return st_->reverse_lexicographic_order(sh1, sh2);
     }
+  }
 
-    Simplex_tree * st_;
-  };
+  /* Sorts filtration_vect_ stably by filtration value. The filtration values are floating point numbers, so they are
+   * radix sorted on their bit patterns. */
+  void sort_by_filtration(std::true_type) {
+    typedef Filtration_radix_key<Filtration_value> Radix_key;
+    std::vector<std::pair<typename Radix_key::Key, Simplex_handle>> keys;
+    keys.reserve(filtration_vect_.size());
+    for (Simplex_handle sh : filtration_vect_)
+      // Not using filtration(sh) because it uselessly tests for null_simplex.
+      keys.emplace_back(Radix_key::key(sh->second.filtration()), sh);
+    radix_sort_by_key(keys);
+    for (std::size_t i = 0; i < keys.size(); ++i)
+      filtration_vect_[i] = keys[i].second;
+  }
+
+  /* Sorts filtration_vect_ stably by filtration value, in parallel if TBB is available. The position in
+   * filtration_vect_ breaks the ties, so that any sort algorithm is stable. */
+  void sort_by_filtration(std::false_type) {
+    std::vector<std::pair<Filtration_value, std::size_t>> keys;
+    keys.reserve(filtration_vect_.size());
+    for (std::size_t i = 0; i < filtration_vect_.size(); ++i)
+      keys.emplace_back(filtration_vect_[i]->second.filtration(), i);
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_sort(keys.begin(), keys.end());
+#else
+    std::sort(keys.begin(), keys.end());
+#endif
+    std::vector<Simplex_handle> sorted;
+    sorted.reserve(keys.size());
+    for (auto const& key : keys)
+      sorted.push_back(filtration_vect_[key.second]);
+    filtration_vect_.swap(sorted);
+  }
 
  public:
   /** \brief Inserts a 1-skeleton in an empty Simplex_tree.
@@ -1028,12 +1381,62 @@ class Simplex_tree {
       if (v < u) std::swap(u, v);
       auto sh = find_vertex(u);
       if (!has_children(sh)) {
-        sh->second.assign_children(new Siblings(&root_, sh->first));
+        sh->second.assign_children(new_siblings(&root_, sh->first));
       }
 
-      sh->second.children()->members().emplace(v,
-          Node(sh->second.children(), boost::get(edge_filtration_t(), skel_graph, *e_it)));
+      children(sh)->members().emplace(v,
+          Node(children(sh), boost::get(edge_filtration_t(), skel_graph, *e_it)));
+    }
+  }
+
+  /** \brief Inserts a 1-skeleton stored in compressed sparse row format in an empty Simplex_tree.
+   *
+   * The Simplex_tree must contain no simplex when the method is
+   * called.
+   *
+   * As the upper neighbors of each vertex are already sorted and unique in a `One_skeleton_csr_graph`, the set of
+   * children of each vertex is built in one go, without any search. The sets of children are built in parallel if
+   * TBB is available. */
+  template<typename GraphFiltrationValue, typename GraphVertexHandle>
+  void insert_graph(const One_skeleton_csr_graph<GraphFiltrationValue, GraphVertexHandle>& skel_graph) {
+    // the simplex tree must be empty
+    assert(num_simplices() == 0);
+
+    const std::size_t num_vertices = skel_graph.num_vertices();
+    if (num_vertices == 0) {
+      return;
+    }
+    if (skel_graph.num_edges() == 0) {
+      dimension_ = 0;
+    } else {
+      dimension_ = 1;
+    }
+
+    root_.members_.reserve(num_vertices);
+    for (std::size_t u = 0; u < num_vertices; ++u) {
+      root_.members_.emplace_hint(root_.members_.end(), static_cast<Vertex_handle>(u),
+                                  Node(&root_, skel_graph.vertex_filtration(u)));
     }
+
+    // The vertices are 0, ..., num_vertices - 1, so the vertex u is at position u in root_.
+    auto insert_children = [&](std::size_t u) {
+      auto neighbors = skel_graph.upper_neighbors(u);
+      if (neighbors.empty())
+        return;
+      auto fil_it = skel_graph.upper_edge_filtrations(u).begin();
+      thread_local std::vector<std::pair<Vertex_handle, Node>> children;
+      children.clear();
+      for (auto v : neighbors)
+        children.emplace_back(static_cast<Vertex_handle>(v), Node(nullptr, *fil_it++));
+      Dictionary_it sh = root_.members_.begin() + u;
+      sh->second.assign_children(new_siblings(&root_, sh->first, children));
+    };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), num_vertices, insert_children);
+#else
+    for (std::size_t u = 0; u < num_vertices; ++u)
+      insert_children(u);
+#endif
   }
 
   /** \brief Expands the Simplex_tree containing only its one skeleton
@@ -1046,56 +1449,86 @@ class Simplex_tree {
    * value of one of its edges.
    *
    * The Simplex_tree must contain no simplex of dimension bigger than
-   * 1 when calling the method. */
+   * 1 when calling the method.
+   *
+   * If TBB is available, the subtrees rooted at the different vertices (and at the nodes of large sets of siblings)
+   * are expanded in parallel, as they are independent once the 1-skeleton is in place. */
   void expansion(int max_dim) {
-    dimension_ = max_dim;
-    for (Dictionary_it root_it = root_.members_.begin();
-         root_it != root_.members_.end(); ++root_it) {
-      if (has_children(root_it)) {
-        siblings_expansion(root_it->second.children(), max_dim - 1);
-      }
-    }
-    dimension_ = max_dim - dimension_;
+    int min_k = min_over_members(&root_, max_dim, true, [&](Dictionary_it root_it) -> int {
+      if (has_children(root_it))
+        return siblings_expansion(children(root_it), max_dim - 1);
+      return max_dim;
+    });
+    dimension_ = max_dim - min_k;
   }
 
  private:
-  /** \brief Recursive expansion of the simplex tree.*/
-  void siblings_expansion(Siblings * siblings,  // must contain elements
-                          int k) {
-    if (dimension_ > k) {
-      dimension_ = k;
-    }
+  /** \brief Recursive expansion of the simplex tree.
+   * @return The smallest value of k reached in the recursion. */
+  int siblings_expansion(Siblings * siblings,  // must contain elements
+                         int k) {
     if (k == 0)
-      return;
-    Dictionary_it next = siblings->members().begin();
-    ++next;
-
+      return 0;
+    // Below this size, the expansion of a set of siblings is not worth being split in parallel tasks.
+    const std::size_t parallel_min_size = 256;
+    return min_over_members(siblings, k, siblings->members().size() >= parallel_min_size,
+                            [&](Dictionary_it s_h) -> int { return node_expansion(siblings, s_h, k); });
+  }
+
+  /** \brief Expansion of the subtree rooted at s_h, which belongs to siblings.
+   * @return The smallest value of k reached in the recursion. */
+  int node_expansion(Siblings * siblings, Dictionary_it s_h, int k) {
+    Simplex_handle root_sh = find_vertex(s_h->first);
+    if (!has_children(root_sh))
+      return k;
     thread_local std::vector<std::pair<Vertex_handle, Node> > inter;
-    for (Dictionary_it s_h = siblings->members().begin();
-         s_h != siblings->members().end(); ++s_h, ++next) {
-      Simplex_handle root_sh = find_vertex(s_h->first);
-      if (has_children(root_sh)) {
-        intersection(
-                     inter,  // output intersection
-                     next,  // begin
-                     siblings->members().end(),  // end
-                     root_sh->second.children()->members().begin(),
-                     root_sh->second.children()->members().end(),
-                     s_h->second.filtration());
-        if (inter.size() != 0) {
-          Siblings * new_sib = new Siblings(siblings,  // oncles
-                                            s_h->first,  // parent
-                                            inter);  // boost::container::ordered_unique_range_t
-          inter.clear();
-          s_h->second.assign_children(new_sib);
-          siblings_expansion(new_sib, k - 1);
-        } else {
-          // ensure the children property
-          s_h->second.assign_children(siblings);
-          inter.clear();
-        }
-      }
+    intersection(
+                 inter,  // output intersection
+                 s_h + 1,  // begin
+                 siblings->members().end(),  // end
+                 children(root_sh)->members().begin(),
+                 children(root_sh)->members().end(),
+                 s_h->second.filtration());
+    if (inter.size() != 0) {
+      Siblings * new_sib = new_siblings(siblings,  // oncles
+                                        s_h->first,  // parent
+                                        inter);  // boost::container::ordered_unique_range_t
+      inter.clear();
+      s_h->second.assign_children(new_sib);
+      return siblings_expansion(new_sib, k - 1);
+    } else {
+      // ensure the children property
+      s_h->second.assign_children(siblings);
+      inter.clear();
+      return k;
+    }
+  }
+
+  /** \brief Returns the minimum of init and of fun(sh) for all the members sh of siblings.
+   *
+   * If TBB is available and parallel is true, fun is called in parallel tasks. fun must then only modify the
+   * subtree rooted at its argument. */
+  template<typename Function>
+  int min_over_members(Siblings * siblings, int init, bool parallel, Function fun) {
+    Dictionary_it first = siblings->members().begin();
+    std::size_t size = siblings->members().size();
+#ifdef GUDHI_USE_TBB
+    if (parallel) {
+      return tbb::parallel_reduce(tbb::blocked_range<std::size_t>(0, size), init,
+                                  [&](const tbb::blocked_range<std::size_t>& range, int min_value) {
+                                    for (std::size_t idx = range.begin(); idx != range.end(); ++idx)
+                                      min_value = (std::min)(min_value, fun(first + idx));
+                                    return min_value;
+                                  },
+                                  [](int value_1, int value_2) { return (std::min)(value_1, value_2); });
     }
+#else
+    (void)parallel;
+#endif
+    int min_value = init;
+    for (std::size_t idx = 0; idx != size; ++idx)
+      min_value = (std::min)(min_value, fun(first + idx));
+    return min_value;
   }
 
   /** \brief Intersects Dictionary 1 [begin1;end1) with Dictionary 2 [begin2,end2)
@@ -1146,7 +1579,7 @@ class Simplex_tree {
     // Loop must be from the end to the beginning, as higher dimension simplex are always on the left part of the tree
     for (auto& simplex : boost::adaptors::reverse(root_.members())) {
       if (has_children(&simplex)) {
-        siblings_expansion_with_blockers(simplex.second.children(), max_dim, max_dim - 1, block_simplex);
+        siblings_expansion_with_blockers(children(&simplex), max_dim, max_dim - 1, block_simplex);
       }
     }
   }
@@ -1184,7 +1617,7 @@ class Simplex_tree {
       }
       if (intersection.size() != 0) {
         // Reverse the order to insert
-        Siblings * new_sib = new Siblings(siblings,  // oncles
+        Siblings * new_sib = new_siblings(siblings,  // oncles
                                           simplex->first,  // parent
                                           boost::adaptors::reverse(intersection));  // boost::container::ordered_unique_range_t
         std::vector<Vertex_handle> blocked_new_sib_vertex_list;
@@ -1201,7 +1634,7 @@ class Simplex_tree {
         }
         if (blocked_new_sib_vertex_list.size() == new_sib->members().size()) {
           // Specific case where all have to be deleted
-          delete new_sib;
+          delete_siblings(new_sib);
           // ensure the children property
           simplex->second.assign_children(siblings);
         } else {
@@ -1227,10 +1660,10 @@ class Simplex_tree {
     if (!has_children(sh))
       return null_simplex();
 
-    Simplex_handle child = sh->second.children()->find(vh);
+    Simplex_handle child = children(sh)->find(vh);
     // Specific case of boost::flat_map does not find, returns boost::flat_map::end()
     // in simplex tree we want a null_simplex()
-    if (child == sh->second.children()->members().end())
+    if (child == children(sh)->members().end())
       return null_simplex();
 
     return child;
@@ -1254,6 +1687,176 @@ class Simplex_tree {
     }
   }
 
+ public:
+  /** \name Binary serialization
+   * @{ */
+
+  /** \brief Returns the number of bytes written by `serialize()`. */
+  std::size_t get_serialization_size() {
+    std::size_t num_simplices = this->num_simplices();
+    // Every simplex is a member of a set of siblings, and has a set of children (empty for a leaf)
+    return serialization_header_size + (num_simplices + 1) * sizeof(Vertex_handle) +
+        num_simplices * serialization_member_size;
+  }
+
+  /** \brief Writes the simplex tree in buffer, in the binary format read by `deserialize()`.
+   *
+   * The format starts with a header of 24 bytes, which records the sizes of the types of the simplex tree, the byte
+   * order of the machine and the dimension. The set of vertices follows, and each set of siblings is written as its
+   * number of members, then the vertex, the filtration value (if `Options::store_filtration`) and the key (if
+   * `Options::store_key`) of each member, then the sets of children of the members, depth-first. A leaf has an empty
+   * set of children. Numbers are written with the byte order of the machine.
+   *
+   * @param[in] buffer Memory where the simplex tree is written.
+   * @param[in] buffer_size Size of buffer, at least `get_serialization_size()`.
+   * @exception std::invalid_argument If buffer_size is too small.
+   */
+  void serialize(char* buffer, std::size_t buffer_size) {
+    if (buffer_size < get_serialization_size())
+      throw std::invalid_argument("Simplex_tree::serialize - buffer is too small");
+    Serialization_buffer_output output(buffer);
+    serialize_to(output);
+  }
+
+  /** \brief Writes the simplex tree in os, in one pass, in the binary format of `serialize(char*, std::size_t)`.
+   *
+   * os must be opened in binary mode. */
+  void serialize(std::ostream& os) {
+    Serialization_stream_output output(os);
+    serialize_to(output);
+  }
+
+  /** \brief Builds the simplex tree written in buffer by `serialize()`.
+   *
+   * The sets of siblings are built directly from the members they had in the serialized tree, without any search.
+   * Keys are restored when `Options::store_key` is true. The buffer can be a read-only memory mapped file, see
+   * `read_simplex_tree_binary_file()`.
+   *
+   * @param[in] buffer Memory where a simplex tree with the same `Vertex_handle`, `Filtration_value` and `Simplex_key`
+   * types was serialized, on a machine with the same byte order.
+   * @param[in] buffer_size Size of buffer, as returned by `get_serialization_size()` on the serialized tree.
+   * @exception std::invalid_argument If buffer does not contain exactly a serialized simplex tree of this type.
+   * \pre The simplex tree must be empty.
+   */
+  void deserialize(const char* buffer, std::size_t buffer_size) {
+    GUDHI_CHECK(num_vertices() == 0, std::invalid_argument("Simplex_tree::deserialize - the simplex tree is not empty"));
+    char header[serialization_header_size];
+    serialize_header(header);
+    // The header ends with the dimension
+    const std::size_t dimension_offset = serialization_header_size - sizeof(std::int64_t);
+    if (buffer_size < serialization_header_size || std::memcmp(header, buffer, dimension_offset) != 0)
+      throw std::invalid_argument("Simplex_tree::deserialize - not a serialized simplex tree of this type");
+    std::int64_t dimension;
+    deserialize_trivial(dimension, buffer + dimension_offset);
+
+    const char* end = buffer + buffer_size;
+    Vertex_handle num_vertices;
+    const char* ptr = deserialize_siblings_size(num_vertices, buffer + serialization_header_size, end);
+    ptr = rec_deserialize(&root_, num_vertices, ptr, end);
+    if (ptr != end)
+      throw std::invalid_argument("Simplex_tree::deserialize - unexpected data after the simplex tree");
+    dimension_ = static_cast<int>(dimension);
+  }
+  /** @} */  // end binary serialization
+
+ private:
+  static const std::size_t serialization_header_size = 24;
+  static const std::size_t serialization_filtration_size = Options::store_filtration ? sizeof(Filtration_value) : 0;
+  static const std::size_t serialization_key_size = Options::store_key ? sizeof(Simplex_key) : 0;
+  static const std::size_t serialization_member_size =
+      sizeof(Vertex_handle) + serialization_filtration_size + serialization_key_size;
+
+  /* Writes the magic string, byte order mark, sizes of the types and dimension. */
+  char* serialize_header(char* ptr) {
+    std::memcpy(ptr, "GUDHI_ST", 8);
+    ptr = serialize_trivial(static_cast<std::uint32_t>(0x01020304), ptr + 8);
+    ptr = serialize_trivial(static_cast<std::uint8_t>(sizeof(Vertex_handle)), ptr);
+    ptr = serialize_trivial(static_cast<std::uint8_t>(serialization_filtration_size), ptr);
+    ptr = serialize_trivial(static_cast<std::uint8_t>(serialization_key_size), ptr);
+    ptr = serialize_trivial(static_cast<std::uint8_t>(1), ptr);  // version of the format
+    return serialize_trivial(static_cast<std::int64_t>(dimension_), ptr);
+  }
+
+  template<class Output>
+  void serialize_to(Output& output) {
+    serialize_header(output.reserve(serialization_header_size));
+    rec_serialize(&root_, output);
+    output.flush();
+  }
+
+  template<class Output>
+  void rec_serialize(Siblings* sib, Output& output) {
+    char* ptr = output.reserve(sizeof(Vertex_handle) + sib->members().size() * serialization_member_size);
+    ptr = serialize_trivial(static_cast<Vertex_handle>(sib->members().size()), ptr);
+    for (auto sh = sib->members().begin(); sh != sib->members().end(); ++sh) {
+      ptr = serialize_trivial(sh->first, ptr);
+      if (Options::store_filtration)
+        ptr = serialize_trivial(sh->second.filtration(), ptr);
+      ptr = serialize_key(sh, ptr, std::integral_constant<bool, Options::store_key>());
+    }
+    for (auto sh = sib->members().begin(); sh != sib->members().end(); ++sh) {
+      if (has_children(sh))
+        rec_serialize(children(sh), output);
+      else
+        serialize_trivial(static_cast<Vertex_handle>(0), output.reserve(sizeof(Vertex_handle)));
+    }
+  }
+
+  char* serialize_key(Simplex_handle sh, char* ptr, std::true_type) {
+    return serialize_trivial(sh->second.key(), ptr);
+  }
+
+  char* serialize_key(Simplex_handle, char* ptr, std::false_type) {
+    return ptr;
+  }
+
+  const char* deserialize_siblings_size(Vertex_handle& size, const char* ptr, const char* end) {
+    if (static_cast<std::size_t>(end - ptr) < sizeof(Vertex_handle))
+      throw std::invalid_argument("Simplex_tree::deserialize - truncated simplex tree");
+    ptr = deserialize_trivial(size, ptr);
+    if (size < 0 || static_cast<std::size_t>(end - ptr) / serialization_member_size < static_cast<std::size_t>(size))
+      throw std::invalid_argument("Simplex_tree::deserialize - truncated simplex tree");
+    return ptr;
+  }
+
+  /* Reads the members of sib, then their children. */
+  const char* rec_deserialize(Siblings* sib, Vertex_handle size, const char* ptr, const char* end) {
+    sib->members_.reserve(size);
+    for (Vertex_handle i = 0; i < size; ++i) {
+      Vertex_handle vertex;
+      Filtration_value filtration = 0;
+      ptr = deserialize_trivial(vertex, ptr);
+      if (Options::store_filtration)
+        ptr = deserialize_trivial(filtration, ptr);
+      // The vertices were written in increasing order, the hint avoids any search
+      auto sh = sib->members_.emplace_hint(sib->members_.end(), vertex, Node(sib, filtration));
+      ptr = deserialize_key(sh, ptr, std::integral_constant<bool, Options::store_key>());
+    }
+    if (static_cast<Vertex_handle>(sib->members_.size()) != size)
+      throw std::invalid_argument("Simplex_tree::deserialize - repeated vertex in a simplex tree");
+    for (auto sh = sib->members_.begin(); sh != sib->members_.end(); ++sh) {
+      Vertex_handle num_children;
+      ptr = deserialize_siblings_size(num_children, ptr, end);
+      if (num_children > 0) {
+        Siblings* children = new_siblings(sib, sh->first);
+        sh->second.assign_children(children);
+        ptr = rec_deserialize(children, num_children, ptr, end);
+      }
+    }
+    return ptr;
+  }
+
+  const char* deserialize_key(Dictionary_it sh, const char* ptr, std::true_type) {
+    Simplex_key key;
+    ptr = deserialize_trivial(key, ptr);
+    sh->second.assign_key(key);
+    return ptr;
+  }
+
+  const char* deserialize_key(Dictionary_it, const char* ptr, std::false_type) {
+    return ptr;
+  }
+
  public:
   /** \brief Browse the simplex tree to ensure the filtration is not decreasing.
    * The simplex tree is browsed starting from the root until the leaf, and the filtration values are set with their
@@ -1268,7 +1871,7 @@ class Simplex_tree {
     // Loop must be from the end to the beginning, as higher dimension simplex are always on the left part of the tree
     for (auto& simplex : boost::adaptors::reverse(root_.members())) {
       if (has_children(&simplex)) {
-        modified |= rec_make_filtration_non_decreasing(simplex.second.children());
+        modified |= rec_make_filtration_non_decreasing(children(&simplex));
       }
     }
     return modified;
@@ -1298,7 +1901,7 @@ class Simplex_tree {
         simplex.second.assign_filtration(max_filt_border_value);
       }
       if (has_children(&simplex)) {
-        modified |= rec_make_filtration_non_decreasing(simplex.second.children());
+        modified |= rec_make_filtration_non_decreasing(children(&simplex));
       }
     }
     // Make the modified information to be traced by upper call
@@ -1325,7 +1928,7 @@ class Simplex_tree {
     auto&& list = sib->members();
     auto last = std::remove_if(list.begin(), list.end(), [=](Dit_value_t& simplex) {
         if (simplex.second.filtration() <= filt) return false;
-        if (has_children(&simplex)) rec_delete(simplex.second.children());
+        if (has_children(&simplex)) rec_delete(children(&simplex));
         // dimension may need to be lowered
         dimension_to_be_lowered_ = true;
         return true;
@@ -1335,7 +1938,7 @@ class Simplex_tree {
     if (last == list.begin() && sib != root()) {
       // Removing the whole siblings, parent becomes a leaf.
       sib->oncles()->members()[sib->parent()].assign_children(sib->oncles());
-      delete sib;
+      delete_siblings(sib);
       // dimension may need to be lowered
       dimension_to_be_lowered_ = true;
       return true;
@@ -1344,7 +1947,7 @@ class Simplex_tree {
       list.erase(last, list.end());
       for (auto&& simplex : list)
         if (has_children(&simplex))
-          modified |= rec_prune_above_filtration(simplex.second.children(), filt);
+          modified |= rec_prune_above_filtration(children(&simplex), filt);
     }
     return modified;
   }
@@ -1395,7 +1998,7 @@ class Simplex_tree {
                 std::invalid_argument("Simplex_tree::remove_maximal_simplex - argument has children"));
 
     // Simplex is a leaf, it means the child is the Siblings owning the leaf
-    Siblings* child = sh->second.children();
+    Siblings* child = children(sh);
 
     if ((child->size() > 1) || (child == root())) {
       // Not alone, just remove it from members
@@ -1404,7 +2007,7 @@ class Simplex_tree {
     } else {
       // Sibling is emptied : must be deleted, and its parent must point on his own Sibling
       child->oncles()->members().at(child->parent()).assign_children(child->oncles());
-      delete child;
+      delete_siblings(child);
       // dimension may need to be lowered
       dimension_to_be_lowered_ = true;
     }
@@ -1412,13 +2015,20 @@ class Simplex_tree {
 
  private:
   Vertex_handle null_vertex_;
+  /** \brief Table of the sets of siblings with the packed_nodes option, nullptr otherwise. Declared before root_,
+   * which registers in it.*/
+  std::unique_ptr<Siblings_pool> pool_;
   /** \brief Total number of simplices in the complex, without the empty simplex.*/
   /** \brief Set of simplex tree Nodes representing the vertices.*/
   Siblings root_;
   /** \brief Simplices ordered according to a filtration.*/
   std::vector<Simplex_handle> filtration_vect_;
+  /** \brief Keys of the boundaries of the simplices, in the order of the filtration.*/
+  Simplex_tree_boundary_keys<Simplex_key> boundary_keys_;
   /** \brief Upper bound on the dimension of the simplicial complex.*/
   int dimension_;
+  /** \brief Memory of the siblings with the arena_allocation option, nullptr otherwise.*/
+  std::unique_ptr<Simplex_tree_arena> arena_;
   bool dimension_to_be_lowered_ = false;
 };
 
@@ -1487,6 +2097,22 @@ struct Simplex_tree_options_fast_persistence {
   static const bool contiguous_vertices = true;
 };
 
+/** Model of SimplexTreeOptions with the same features as `Simplex_tree_options_full_featured`, but with `float`
+ * filtration values and packed nodes. A member of a set of siblings takes 16 bytes instead of 32.
+ *
+ * Maximum number of simplices to compute persistence is <CODE>std::numeric_limits<std::uint32_t>::max()</CODE>
+ * (about 4 billions of simplices), and maximum number of sets of siblings in a tree is about 4 billions. */
+struct Simplex_tree_options_packed {
+  typedef linear_indexing_tag Indexing_tag;
+  typedef int Vertex_handle;
+  typedef float Filtration_value;
+  typedef std::uint32_t Simplex_key;
+  static const bool store_key = true;
+  static const bool store_filtration = true;
+  static const bool contiguous_vertices = false;
+  static const bool packed_nodes = true;
+};
+
 /** @} */  // end defgroup simplex_tree
 
 }  // namespace Gudhi
@@ -0,0 +1,230 @@
+/*    This file is part of the Gudhi Library. The Gudhi library
+ *    (Geometric Understanding in Higher Dimensions) is a generic C++
+ *    library for computational topology.
+ *
+ *    Author(s):       Gudhi contributors
+ *
+ *    Copyright (C) 2018 Inria
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIMPLEX_TREE_FROZEN_SIMPLEX_TREE_H_
+#define SIMPLEX_TREE_FROZEN_SIMPLEX_TREE_H_
+
+#include <gudhi/Debug_utils.h>
+#include <gudhi/Simplex_tree/Simplex_tree_boundary_keys.h>
+
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include <vector>
+#include <utility>  // for std::pair
+#include <algorithm>  // for std::max
+#include <limits>  // for std::numeric_limits
+#include <stdexcept>  // for std::out_of_range, std::invalid_argument
+#include <cstddef>  // for std::size_t
+
+namespace Gudhi {
+
+/** \addtogroup simplex_tree
+ * @{
+ */
+
+/** \brief Compact read-only representation of a filtered simplicial complex, for persistence computations.
+ *
+ * \details Built by `Simplex_tree::freeze()`. The simplices are stored in the order of the filtration, and a simplex
+ * is represented by its position in this order. For each simplex, the frozen simplex tree stores its filtration
+ * value, its key, and the positions of the simplices of its boundary, contiguously. The vertices of the simplices are
+ * not stored.
+ *
+ * Enumerating the boundary of a simplex is thus a linear scan of a few integers, instead of one search in the simplex
+ * tree for each facet, and the whole structure takes about two thirds of the memory of the simplex tree.
+ *
+ * \implements FilteredComplex
+ */
+template<typename SimplexTreeOptions>
+class Frozen_simplex_tree {
+ public:
+  typedef SimplexTreeOptions Options;
+  typedef typename Options::Indexing_tag Indexing_tag;
+  typedef typename Options::Filtration_value Filtration_value;
+  typedef typename Options::Simplex_key Simplex_key;
+  /** \brief Position of the simplex in the filtration. */
+  typedef Simplex_key Simplex_handle;
+
+  typedef boost::counting_iterator<Simplex_handle> Filtration_simplex_iterator;
+  typedef boost::iterator_range<Filtration_simplex_iterator> Filtration_simplex_range;
+
+  typedef typename Simplex_tree_boundary_keys<Simplex_handle>::Iterator Boundary_simplex_iterator;
+  typedef typename Simplex_tree_boundary_keys<Simplex_handle>::Range Boundary_simplex_range;
+
+  /** \brief Iterator over the boundary of a simplex, with the alternating coefficients +1 and -1. */
+  class Boundary_oriented_simplex_iterator
+      : public boost::iterator_facade<Boundary_oriented_simplex_iterator, std::pair<Simplex_handle, int>,
+                                      std::input_iterator_tag, std::pair<Simplex_handle, int>> {
+   public:
+    Boundary_oriented_simplex_iterator(Boundary_simplex_iterator it, int coef) : it_(it), coef_(coef) { }
+
+   private:
+    friend class boost::iterator_core_access;
+
+    void increment() {
+      ++it_;
+      coef_ = -coef_;
+    }
+
+    std::pair<Simplex_handle, int> dereference() const {
+      return std::pair<Simplex_handle, int>(*it_, coef_);
+    }
+
+    bool equal(const Boundary_oriented_simplex_iterator& other) const {
+      return it_ == other.it_;
+    }
+
+    Boundary_simplex_iterator it_;
+    int coef_;
+  };
+  typedef boost::iterator_range<Boundary_oriented_simplex_iterator> Boundary_oriented_simplex_range;
+
+  typedef typename std::vector<Simplex_handle>::const_iterator Skeleton_simplex_iterator;
+  typedef boost::iterator_range<Skeleton_simplex_iterator> Skeleton_simplex_range;
+
+  /** \brief Copies the simplices of a complex, in the order of its filtration.
+   *
+   * The coefficients of the boundaries of cpx must alternate, starting with \f$(-1)^d\f$ for a simplex of dimension
+   * \f$d\f$, as in `Simplex_tree`. The keys of the simplices of cpx are set to their positions in the filtration. If
+   * TBB is available, the boundaries are computed in parallel.
+   *
+   * @exception std::out_of_range If the number of simplices does not fit in `Simplex_key`.
+   */
+  template<class FilteredComplex>
+  explicit Frozen_simplex_tree(FilteredComplex& cpx)
+      : filtrations_(cpx.num_simplices()),
+        keys_(filtrations_.size()),
+        dimension_(-1) {
+    std::size_t num_simplices = filtrations_.size();
+    if (num_simplices >= static_cast<std::size_t>(null_simplex()))
+      throw std::out_of_range("Frozen_simplex_tree - the number of simplices does not fit in Simplex_key");
+    boundaries_.reserve(num_simplices);
+    Simplex_key position = 0;
+    for (auto sh : cpx.filtration_simplex_range()) {
+      cpx.assign_key(sh, position);
+      keys_[position] = position;
+      filtrations_[position] = cpx.filtration(sh);
+      int dim = cpx.dimension(sh);
+      if (dim == 0)
+        vertices_.push_back(position);
+      boundaries_.add_simplex(dim == 0 ? 0 : dim + 1);
+      dimension_ = (std::max)(dimension_, dim);
+      ++position;
+    }
+    boundaries_.fill([&](Simplex_handle sh, typename std::vector<Simplex_handle>::iterator output) {
+      for (auto b_sh : cpx.boundary_oriented_simplex_range(cpx.simplex(sh)))
+        *output++ = cpx.key(b_sh.first);
+    });
+  }
+
+  /** \brief Returns the number of simplices in the complex. */
+  std::size_t num_simplices() const {
+    return filtrations_.size();
+  }
+
+  /** \brief Returns the dimension of the complex. */
+  int dimension() const {
+    return dimension_;
+  }
+
+  /** \brief Returns the dimension of a simplex. */
+  int dimension(Simplex_handle sh) const {
+    std::size_t size = boundaries_.size(sh);
+    return size == 0 ? 0 : static_cast<int>(size) - 1;
+  }
+
+  /** \brief Returns the filtration value of a simplex, or infinity for `null_simplex()`. */
+  Filtration_value filtration(Simplex_handle sh) const {
+    if (sh == null_simplex()) return std::numeric_limits<Filtration_value>::infinity();
+    return filtrations_[sh];
+  }
+
+  /** \brief Returns a range over the simplices in the order of the filtration. */
+  Filtration_simplex_range filtration_simplex_range() const {
+    return Filtration_simplex_range(Filtration_simplex_iterator(0),
+                                    Filtration_simplex_iterator(static_cast<Simplex_handle>(num_simplices())));
+  }
+
+  /** \brief Does nothing, the simplices are already in the order of the filtration. */
+  void initialize_filtration() { }
+
+  /** \brief Returns the simplices of the boundary of a simplex, in the order of
+   * `Simplex_tree::boundary_oriented_simplex_range()`. */
+  Boundary_simplex_range boundary_simplex_range(Simplex_handle sh) const {
+    return boundaries_.range(sh);
+  }
+
+  /** \brief Returns the simplices of the boundary of a simplex, with alternating coefficients starting with
+   * \f$(-1)^d\f$, where \f$d\f$ is the dimension of the simplex. */
+  Boundary_oriented_simplex_range boundary_oriented_simplex_range(Simplex_handle sh) const {
+    Boundary_simplex_range boundary = boundaries_.range(sh);
+    return Boundary_oriented_simplex_range(
+        Boundary_oriented_simplex_iterator(boundary.begin(), boundary.size() % 2 == 1 ? 1 : -1),
+        Boundary_oriented_simplex_iterator(boundary.end(), 1));
+  }
+
+  /** \brief Returns the two vertices of an edge. */
+  std::pair<Simplex_handle, Simplex_handle> endpoints(Simplex_handle sh) const {
+    auto ptr = boundaries_.range(sh).begin();
+    return std::pair<Simplex_handle, Simplex_handle>(ptr[0], ptr[1]);
+  }
+
+  /** \brief Returns the vertices. Only dimension 0 is supported. */
+  Skeleton_simplex_range skeleton_simplex_range(int GUDHI_CHECK_code(dim) = 0) const {
+    GUDHI_CHECK(dim == 0, std::invalid_argument("Frozen_simplex_tree::skeleton_simplex_range - dimension must be 0"));
+    return Skeleton_simplex_range(vertices_.begin(), vertices_.end());
+  }
+
+  /** \brief Returns the simplex at position idx in the filtration. */
+  Simplex_handle simplex(Simplex_key idx) const {
+    return idx;
+  }
+
+  Simplex_handle null_simplex() const {
+    return static_cast<Simplex_handle>(-1);
+  }
+
+  Simplex_key null_key() const {
+    return static_cast<Simplex_key>(-1);
+  }
+
+  Simplex_key key(Simplex_handle sh) const {
+    return keys_[sh];
+  }
+
+  void assign_key(Simplex_handle sh, Simplex_key key) {
+    keys_[sh] = key;
+  }
+
+ private:
+  std::vector<Filtration_value> filtrations_;
+  std::vector<Simplex_key> keys_;
+  Simplex_tree_boundary_keys<Simplex_handle> boundaries_;
+  std::vector<Simplex_handle> vertices_;
+  int dimension_;
+};
+
+/** @} */  // end addtogroup simplex_tree
+}  // namespace Gudhi
+
+#endif  // SIMPLEX_TREE_FROZEN_SIMPLEX_TREE_H_
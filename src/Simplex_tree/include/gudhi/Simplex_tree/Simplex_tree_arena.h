@@ -0,0 +1,230 @@
+/*    This file is part of the Gudhi Library. The Gudhi library
+ *    (Geometric Understanding in Higher Dimensions) is a generic C++
+ *    library for computational topology.
+ *
+ *    Author(s):       Gudhi contributors
+ *
+ *    Copyright (C) 2018 Inria
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIMPLEX_TREE_SIMPLEX_TREE_ARENA_H_
+#define SIMPLEX_TREE_SIMPLEX_TREE_ARENA_H_
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/enumerable_thread_specific.h>
+#endif
+
+#include <cstddef>  // for std::size_t
+#include <new>  // for operator new
+#include <vector>
+#include <type_traits>  // for std::false_type
+
+namespace Gudhi {
+
+/* \addtogroup simplex_tree
+ * @{
+ */
+
+/* \brief Memory arena from which a Simplex_tree allocates its sets of siblings and their members.
+ *
+ * Memory is taken from the system by large blocks, cut into chunks whose size is a multiple of 16 bytes (with four
+ * sizes between two consecutive powers of 2 above 256 bytes), and a deallocated chunk is kept in a free list to be
+ * reused by the next allocation of the same size. The blocks are only given back to the system when the arena is
+ * destroyed, so that a whole Simplex_tree is released at once.
+ *
+ * When TBB is available, each thread allocates from its own blocks and free lists, so that sets of siblings can be
+ * created in parallel tasks.*/
+class Simplex_tree_arena {
+ public:
+  Simplex_tree_arena() { }
+  Simplex_tree_arena(const Simplex_tree_arena&) = delete;
+  Simplex_tree_arena& operator=(const Simplex_tree_arena&) = delete;
+
+  void* allocate(std::size_t bytes) {
+    return local().allocate(bytes);
+  }
+
+  /* bytes must be the size given to allocate. */
+  void deallocate(void* p, std::size_t bytes) {
+    local().deallocate(p, bytes);
+  }
+
+ private:
+  /* A chunk in a free list. */
+  struct Free_chunk {
+    Free_chunk* next_;
+  };
+
+  static const std::size_t alignment = 16;
+  static const std::size_t small_chunk_max = 256;
+  static const std::size_t num_size_classes = 16 + 32 * sizeof(std::size_t);
+  static const std::size_t min_block_size = std::size_t(1) << 12;
+  static const std::size_t max_block_size = std::size_t(1) << 20;
+
+  /* Index of the free list for a chunk of the given size, and size of the chunks in this free list. */
+  static std::size_t size_class(std::size_t bytes, std::size_t& chunk_size) {
+    if (bytes <= small_chunk_max) {
+      chunk_size = (bytes + alignment - 1) & ~(alignment - 1);
+      if (chunk_size == 0) chunk_size = alignment;
+      return chunk_size / alignment - 1;
+    }
+    // Four sizes of chunks between two consecutive powers of 2
+    std::size_t base = small_chunk_max;
+    std::size_t index = small_chunk_max / alignment;
+    while (bytes > 2 * base) {
+      base *= 2;
+      index += 4;
+    }
+    std::size_t step = base / 4;
+    std::size_t steps = (bytes - base + step - 1) / step;
+    chunk_size = base + steps * step;
+    return index + steps - 1;
+  }
+
+  /* Blocks and free lists used by one thread. */
+  class Local_arena {
+   public:
+    Local_arena() : current_(nullptr), end_(nullptr), block_size_(min_block_size) {
+      for (Free_chunk*& list : free_lists_) list = nullptr;
+    }
+
+    Local_arena(const Local_arena&) = delete;
+    Local_arena& operator=(const Local_arena&) = delete;
+
+    ~Local_arena() {
+      for (void* block : blocks_) ::operator delete(block);
+    }
+
+    void* allocate(std::size_t bytes) {
+      std::size_t chunk_size;
+      Free_chunk*& list = free_lists_[size_class(bytes, chunk_size)];
+      if (list != nullptr) {
+        Free_chunk* chunk = list;
+        list = chunk->next_;
+        return chunk;
+      }
+      if (chunk_size > block_size_ / 4) {
+        // Too large to be cut from a block, it gets a block of its own
+        return new_block(chunk_size);
+      }
+      if (static_cast<std::size_t>(end_ - current_) < chunk_size) {
+        // The end of the current block is lost
+        current_ = static_cast<char*>(new_block(block_size_));
+        end_ = current_ + block_size_;
+        if (block_size_ < max_block_size) block_size_ *= 2;
+      }
+      void* chunk = current_;
+      current_ += chunk_size;
+      return chunk;
+    }
+
+    void deallocate(void* p, std::size_t bytes) {
+      std::size_t chunk_size;
+      Free_chunk*& list = free_lists_[size_class(bytes, chunk_size)];
+      Free_chunk* chunk = static_cast<Free_chunk*>(p);
+      chunk->next_ = list;
+      list = chunk;
+    }
+
+   private:
+    void* new_block(std::size_t bytes) {
+      blocks_.reserve(blocks_.size() + 1);
+      void* block = ::operator new(bytes);
+      blocks_.push_back(block);
+      return block;
+    }
+
+    std::vector<void*> blocks_;
+    char* current_;
+    char* end_;
+    std::size_t block_size_;
+    Free_chunk* free_lists_[num_size_classes];
+  };
+
+#ifdef GUDHI_USE_TBB
+  Local_arena& local() { return local_arenas_.local(); }
+  tbb::enumerable_thread_specific<Local_arena> local_arenas_;
+#else
+  Local_arena& local() { return local_arena_; }
+  Local_arena local_arena_;
+#endif
+};
+
+/* \brief Allocator for the members of the sets of siblings of a Simplex_tree.
+ *
+ * Allocates from a Simplex_tree_arena, or with operator new when it does not have any (for instance the root of the
+ * Simplex_tree, which is not allocated in the arena). The allocator is propagated along with the memory it allocated
+ * when a container is moved, copied or swapped.*/
+template<class T>
+class Simplex_tree_arena_allocator {
+ public:
+  typedef T value_type;
+  typedef std::true_type propagate_on_container_copy_assignment;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+
+  Simplex_tree_arena_allocator() noexcept : arena_(nullptr) { }
+
+  explicit Simplex_tree_arena_allocator(Simplex_tree_arena* arena) noexcept : arena_(arena) { }
+
+  template<class U>
+  Simplex_tree_arena_allocator(const Simplex_tree_arena_allocator<U>& other) noexcept : arena_(other.arena()) { }
+
+  T* allocate(std::size_t n) {
+    if (arena_ == nullptr) return static_cast<T*>(::operator new(n * sizeof(T)));
+    return static_cast<T*>(arena_->allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, std::size_t n) {
+    if (arena_ == nullptr)
+      ::operator delete(p);
+    else
+      arena_->deallocate(p, n * sizeof(T));
+  }
+
+  Simplex_tree_arena* arena() const noexcept {
+    return arena_;
+  }
+
+ private:
+  Simplex_tree_arena* arena_;
+};
+
+template<class T, class U>
+bool operator==(const Simplex_tree_arena_allocator<T>& a, const Simplex_tree_arena_allocator<U>& b) noexcept {
+  return a.arena() == b.arena();
+}
+
+template<class T, class U>
+bool operator!=(const Simplex_tree_arena_allocator<T>& a, const Simplex_tree_arena_allocator<U>& b) noexcept {
+  return a.arena() != b.arena();
+}
+
+/* \brief Whether SimplexTreeOptions::arena_allocation is defined and true.
+ *
+ * This option is optional, so that the models of SimplexTreeOptions written before it keep working.*/
+template<class SimplexTreeOptions, class = void>
+struct Simplex_tree_uses_arena : std::false_type { };
+
+template<class SimplexTreeOptions>
+struct Simplex_tree_uses_arena<SimplexTreeOptions,
+                               typename std::enable_if<SimplexTreeOptions::arena_allocation>::type>
+    : std::true_type { };
+
+/* @} */  // end addtogroup simplex_tree
+}  // namespace Gudhi
+
+#endif  // SIMPLEX_TREE_SIMPLEX_TREE_ARENA_H_
@@ -0,0 +1,132 @@
+/*    This file is part of the Gudhi Library. The Gudhi library
+ *    (Geometric Understanding in Higher Dimensions) is a generic C++
+ *    library for computational topology.
+ *
+ *    Author(s):       Gudhi contributors
+ *
+ *    Copyright (C) 2018 Inria
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIMPLEX_TREE_SIMPLEX_TREE_BOUNDARY_KEYS_H_
+#define SIMPLEX_TREE_SIMPLEX_TREE_BOUNDARY_KEYS_H_
+
+#include <boost/range/iterator_range.hpp>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#endif
+
+#include <vector>
+#include <algorithm>  // for std::upper_bound
+#include <cstdint>  // for std::uint32_t
+#include <cstddef>  // for std::size_t
+
+namespace Gudhi {
+
+/* \addtogroup simplex_tree
+ * @{
+ */
+
+/* \brief Keys of the boundaries of the simplices of a complex, stored contiguously in the order of the filtration.
+ *
+ * The simplices are numbered 0, 1, ... in the order of the filtration. The sizes of the boundaries are given in this
+ * order by add_simplex(), then fill() computes all the boundaries, in parallel if TBB is available.
+ *
+ * The offsets of the boundaries are stored on 32 bits. The positions where an offset reaches the next multiple of
+ * 2^32 are stored in offset_overflows_, which is empty unless the boundaries are very large.*/
+template<class SimplexKey>
+class Simplex_tree_boundary_keys {
+ public:
+  typedef typename std::vector<SimplexKey>::const_iterator Iterator;
+  typedef boost::iterator_range<Iterator> Range;
+
+  Simplex_tree_boundary_keys() : offsets_(1, 0), size_(0) { }
+
+  void clear() {
+    offsets_.assign(1, 0);
+    offset_overflows_.clear();
+    keys_.clear();
+    size_ = 0;
+  }
+
+  void reserve(std::size_t num_simplices) {
+    offsets_.reserve(num_simplices + 1);
+  }
+
+  /* Appends a simplex whose boundary has boundary_size simplices. */
+  void add_simplex(std::size_t boundary_size) {
+    size_ += boundary_size;
+    SimplexKey position = static_cast<SimplexKey>(offsets_.size());
+    offsets_.push_back(static_cast<std::uint32_t>(size_));
+    while ((size_ >> 32) > offset_overflows_.size())
+      offset_overflows_.push_back(position);
+  }
+
+  /* Number of simplices given to add_simplex(). */
+  std::size_t num_simplices() const {
+    return offsets_.size() - 1;
+  }
+
+  /* Computes the boundaries. boundary(position, output) must write the keys of the boundary of the simplex at
+   * position in the filtration to the iterator output. It is called concurrently when TBB is available. */
+  template<class BoundaryFunction>
+  void fill(BoundaryFunction boundary) {
+    keys_.resize(size_);
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, num_simplices()),
+                      [&](const tbb::blocked_range<std::size_t>& r) {
+      for (std::size_t position = r.begin(); position != r.end(); ++position)
+        fill_simplex(static_cast<SimplexKey>(position), boundary);
+    });
+#else
+    for (std::size_t position = 0; position != num_simplices(); ++position)
+      fill_simplex(static_cast<SimplexKey>(position), boundary);
+#endif
+  }
+
+  /* Keys of the boundary of the simplex at position in the filtration. */
+  Range range(SimplexKey position) const {
+    return Range(keys_.begin() + offset(position), keys_.begin() + offset(position + 1));
+  }
+
+  std::size_t size(SimplexKey position) const {
+    return offset(position + 1) - offset(position);
+  }
+
+ private:
+  template<class BoundaryFunction>
+  void fill_simplex(SimplexKey position, BoundaryFunction& boundary) {
+    if (size(position) != 0)
+      boundary(position, keys_.begin() + offset(position));
+  }
+
+  std::size_t offset(SimplexKey position) const {
+    std::size_t high = std::upper_bound(offset_overflows_.begin(), offset_overflows_.end(), position) -
+        offset_overflows_.begin();
+    return (high << 32) | offsets_[position];
+  }
+
+  std::vector<std::uint32_t> offsets_;
+  std::vector<SimplexKey> offset_overflows_;
+  std::vector<SimplexKey> keys_;
+  std::size_t size_;
+};
+
+/* @} */  // end addtogroup simplex_tree
+}  // namespace Gudhi
+
+#endif  // SIMPLEX_TREE_SIMPLEX_TREE_BOUNDARY_KEYS_H_
@@ -0,0 +1,105 @@
+/*    This file is part of the Gudhi Library. The Gudhi library
+ *    (Geometric Understanding in Higher Dimensions) is a generic C++
+ *    library for computational topology.
+ *
+ *    Author(s):       Gudhi contributors
+ *
+ *    Copyright (C) 2018 Inria
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIMPLEX_TREE_SIMPLEX_TREE_FILTRATION_SORT_H_
+#define SIMPLEX_TREE_SIMPLEX_TREE_FILTRATION_SORT_H_
+
+#include <vector>
+#include <utility>  // for std::pair
+#include <cstring>  // for std::memcpy
+#include <cstdint>  // for std::uint32_t, std::uint64_t
+#include <cstddef>  // for std::size_t
+
+namespace Gudhi {
+
+/* \addtogroup simplex_tree
+ * @{
+ */
+
+/* \brief Maps a filtration value to an unsigned integer with the same order, for radix sorting.
+ *
+ * Only specialized for float and double, is_specialized is false for the other types. */
+template<typename Filtration_value>
+struct Filtration_radix_key {
+  static const bool is_specialized = false;
+};
+
+/* For IEEE floating point numbers, the order of the bit patterns is the order of the values for positive numbers and
+ * the reverse one for negative numbers. Flipping the sign bit of the positive numbers and all the bits of the negative
+ * ones gives an order preserving unsigned integer. Adding 0 turns -0. into +0., which compare equal.*/
+template<typename Float, typename Unsigned>
+struct Floating_point_radix_key {
+  static const bool is_specialized = true;
+  typedef Unsigned Key;
+  static_assert(sizeof(Float) == sizeof(Unsigned), "Unexpected floating point size");
+
+  static Key key(Float value) {
+    value += Float(0);
+    Key bits;
+    std::memcpy(&bits, &value, sizeof(Key));
+    const Key sign = Key(1) << (8 * sizeof(Key) - 1);
+    return (bits & sign) ? ~bits : bits | sign;
+  }
+};
+
+template<>
+struct Filtration_radix_key<float> : Floating_point_radix_key<float, std::uint32_t> { };
+
+template<>
+struct Filtration_radix_key<double> : Floating_point_radix_key<double, std::uint64_t> { };
+
+/* \brief Stable LSD radix sort of a vector of (unsigned key, value) pairs by key, one byte per pass.
+ *
+ * The histograms of all the bytes are computed in a single pass, and the passes on a byte that is the same for all
+ * the keys are skipped, so that a vector with few distinct filtration values costs only a couple of passes.*/
+template<typename Key, typename Value>
+void radix_sort_by_key(std::vector<std::pair<Key, Value>>& elements) {
+  const std::size_t num_bytes = sizeof(Key);
+  const std::size_t size = elements.size();
+  if (size < 2) return;
+  std::vector<std::size_t> histograms(num_bytes * 256, 0);
+  for (auto const& element : elements)
+    for (std::size_t byte = 0; byte < num_bytes; ++byte)
+      ++histograms[byte * 256 + ((element.first >> (8 * byte)) & 0xff)];
+
+  std::vector<std::pair<Key, Value>> buffer;
+  for (std::size_t byte = 0; byte < num_bytes; ++byte) {
+    std::size_t* histogram = &histograms[byte * 256];
+    if (histogram[(elements[0].first >> (8 * byte)) & 0xff] == size) continue;
+    // Exclusive prefix sums give the first position of each bucket
+    std::size_t position = 0;
+    for (int digit = 0; digit < 256; ++digit) {
+      std::size_t count = histogram[digit];
+      histogram[digit] = position;
+      position += count;
+    }
+    buffer.resize(size);
+    for (auto const& element : elements)
+      buffer[histogram[(element.first >> (8 * byte)) & 0xff]++] = element;
+    elements.swap(buffer);
+  }
+}
+
+/* @} */  // end addtogroup simplex_tree
+}  // namespace Gudhi
+
+#endif  // SIMPLEX_TREE_SIMPLEX_TREE_FILTRATION_SORT_H_
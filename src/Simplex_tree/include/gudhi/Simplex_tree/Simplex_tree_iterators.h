@@ -160,13 +160,13 @@ class Simplex_tree_boundary_simplex_iterator : public boost::iterator_facade<
       } else {
         // Dim >= 2, initial step of the descent
         sh_ = for_sib->members_.begin()+*rit;
-        for_sib = sh_->second.children();
+        for_sib = st_->children(sh_);
         ++rit;
       }
     }
     for (; rit != suffix_.rend(); ++rit) {
       sh_ = for_sib->find(*rit);
-      for_sib = sh_->second.children();
+      for_sib = st_->children(sh_);
     }
     sh_ = for_sib->find(last_);  // sh_ points to the right simplex now
     suffix_.push_back(next_);
@@ -257,12 +257,12 @@ class Simplex_tree_oriented_boundary_range {
     if (SimplexTree::Options::contiguous_vertices && new_sib == nullptr) {
       // We reached the root, use a short-cut to find a vertex.
       h = for_sib->members_.begin() + *rit;
-      for_sib = h->second.children();
+      for_sib = st_->children(h);
       ++rit;
     }
     for(; rit != suffix_.rend(); ++rit){
       h = for_sib->find(*rit);
-      for_sib = h->second.children();
+      for_sib = st_->children(h);
     }
     obj_.first = h;
     suffix_.push_back(next_);
@@ -314,7 +314,7 @@ class Simplex_tree_complex_simplex_iterator : public boost::iterator_facade<
       sh_ = st->root()->members().begin();
       sib_ = st->root();
       while (st->has_children(sh_)) {
-        sib_ = sh_->second.children();
+        sib_ = st_->children(sh_);
         sh_ = sib_->members().begin();
       }
     }
@@ -350,7 +350,7 @@ class Simplex_tree_complex_simplex_iterator : public boost::iterator_facade<
       return;
     }
     while (st_->has_children(sh_)) {
-      sib_ = sh_->second.children();
+      sib_ = st_->children(sh_);
       sh_ = sib_->members().begin();
     }
   }
@@ -392,7 +392,7 @@ class Simplex_tree_skeleton_simplex_iterator : public boost::iterator_facade<
       sh_ = st->root()->members().begin();
       sib_ = st->root();
       while (st->has_children(sh_) && curr_dim_ < dim_skel_) {
-        sib_ = sh_->second.children();
+        sib_ = st_->children(sh_);
         sh_ = sib_->members().begin();
         ++curr_dim_;
       }
@@ -430,7 +430,7 @@ class Simplex_tree_skeleton_simplex_iterator : public boost::iterator_facade<
       return;
     }
     while (st_->has_children(sh_) && curr_dim_ < dim_skel_) {
-      sib_ = sh_->second.children();
+      sib_ = st_->children(sh_);
       sh_ = sib_->members().begin();
       ++curr_dim_;
     }
@@ -62,6 +62,13 @@ struct Simplex_tree_node_explicit_storage : SimplexTree::Filtration_simplex_base
     return children_;
   }
 
+  /* Same as children(), with the interface of the nodes that find their children in the pool of siblings of their
+   * tree.*/
+  template<class Pool>
+  Siblings * children(const Pool *) const {
+    return children_;
+  }
+
  private:
   Siblings * children_;
 };
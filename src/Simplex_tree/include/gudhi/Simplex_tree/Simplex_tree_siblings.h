@@ -24,6 +24,7 @@
 #define SIMPLEX_TREE_SIMPLEX_TREE_SIBLINGS_H_
 
 #include <gudhi/Simplex_tree/Simplex_tree_node_explicit_storage.h>
+#include <gudhi/Simplex_tree/Simplex_tree_siblings_pool.h>
 
 #include <boost/container/flat_map.hpp>
 
@@ -40,7 +41,9 @@ namespace Gudhi {
 /* \brief Data structure to store a set of nodes in a SimplexTree sharing
  * the same parent node.*/
 template<class SimplexTree, class MapContainer>
-class Simplex_tree_siblings {
+class Simplex_tree_siblings
+    : public Simplex_tree_pooled_siblings<Simplex_tree_siblings<SimplexTree, MapContainer>,
+                                          Simplex_tree_uses_packed_nodes<typename SimplexTree::Options>::value> {
 // private:
 //  friend SimplexTree;
  public:
@@ -54,35 +57,71 @@ class Simplex_tree_siblings {
   typedef typename SimplexTree::Node Node;
   typedef MapContainer Dictionary;
   typedef typename MapContainer::iterator Dictionary_it;
+  typedef typename MapContainer::allocator_type Allocator;
+  typedef Simplex_tree_pooled_siblings<Simplex_tree_siblings,
+                                       Simplex_tree_uses_packed_nodes<typename SimplexTree::Options>::value>
+      Pooled_siblings;
+  typedef typename Pooled_siblings::Pool Pool;
 
   /* Default constructor.*/
   Simplex_tree_siblings()
-      : oncles_(nullptr),
-        parent_(-1),
+      : parent_(-1),
+        oncles_(nullptr),
         members_() {
   }
 
-  /* Constructor with values.*/
-  Simplex_tree_siblings(Simplex_tree_siblings * oncles, Vertex_handle parent)
-      : oncles_(oncles),
+  /* Constructor of a root, whose tree has the pool of siblings pool (nullptr without packed nodes).*/
+  Simplex_tree_siblings(Pool * pool, Vertex_handle parent)
+      : Pooled_siblings(pool),
         parent_(parent),
+        oncles_(nullptr),
         members_() {
   }
 
+  /* Constructor with values. The members are allocated with alloc.*/
+  Simplex_tree_siblings(Simplex_tree_siblings * oncles, Vertex_handle parent, const Allocator & alloc = Allocator())
+      : Pooled_siblings(oncles->pool()),
+        parent_(parent),
+        oncles_(oncles),
+        members_(alloc) {
+  }
+
   /* \brief Constructor with initialized set of members.
    *
-   * 'members' must be sorted and unique.*/
+   * 'members' must be sorted and unique. They are copied in memory allocated with alloc.*/
   template<typename RandomAccessVertexRange>
-  Simplex_tree_siblings(Simplex_tree_siblings * oncles, Vertex_handle parent, const RandomAccessVertexRange & members)
-      : oncles_(oncles),
+  Simplex_tree_siblings(Simplex_tree_siblings * oncles, Vertex_handle parent, const RandomAccessVertexRange & members,
+                        const Allocator & alloc = Allocator())
+      : Pooled_siblings(oncles->pool()),
         parent_(parent),
+        oncles_(oncles),
         members_(boost::container::ordered_unique_range, members.begin(),
-                 members.end()) {
+                 members.end(), typename Dictionary::key_compare(), alloc) {
     for (auto& map_el : members_) {
       map_el.second.assign_children(this);
     }
   }
 
+  Simplex_tree_siblings(const Simplex_tree_siblings&) = default;
+  Simplex_tree_siblings& operator=(const Simplex_tree_siblings&) = default;
+
+  /* With packed nodes, the nodes that refer to other, i.e. its leaves, refer to this after the move.*/
+  Simplex_tree_siblings(Simplex_tree_siblings&& other)
+      : Pooled_siblings(other.pool()),
+        parent_(other.parent_),
+        oncles_(other.oncles_),
+        members_(std::move(other.members_)) {
+    this->take_index_of(&other);
+  }
+
+  Simplex_tree_siblings& operator=(Simplex_tree_siblings&& other) {
+    oncles_ = other.oncles_;
+    parent_ = other.parent_;
+    members_ = std::move(other.members_);
+    this->take_index_of(&other);
+    return *this;
+  }
+
   /*
    * \brief Inserts a Node in the set of siblings nodes.
    *
@@ -120,8 +159,9 @@ class Simplex_tree_siblings {
     members_.erase(iterator);
   }
 
-  Simplex_tree_siblings * oncles_;
+  // parent_ first, to share the padding with the index of the base with packed nodes
   Vertex_handle parent_;
+  Simplex_tree_siblings * oncles_;
   Dictionary members_;
 };
 
@@ -0,0 +1,269 @@
+/*    This file is part of the Gudhi Library. The Gudhi library
+ *    (Geometric Understanding in Higher Dimensions) is a generic C++
+ *    library for computational topology.
+ *
+ *    Author(s):       Gudhi contributors
+ *
+ *    Copyright (C) 2018 Inria
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIMPLEX_TREE_SIMPLEX_TREE_SIBLINGS_POOL_H_
+#define SIMPLEX_TREE_SIMPLEX_TREE_SIBLINGS_POOL_H_
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/enumerable_thread_specific.h>
+#endif
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <stdexcept>  // for std::length_error
+#include <utility>  // for std::swap
+#include <algorithm>  // for std::min
+#include <type_traits>  // for std::enable_if
+#include <cstdint>  // for std::uint32_t, std::uint64_t
+
+namespace Gudhi {
+
+/* \addtogroup simplex_tree
+ * @{
+ */
+
+/* \brief Table of the sets of siblings of a simplex tree with packed nodes, whose nodes refer to them by a 32 bits
+ * index instead of a pointer.
+ *
+ * Each tree owns its table, so that the limit of 2^32 - 1 sets of siblings is per tree. The table grows by segments of
+ * doubling sizes, which are never moved, so that at() can be called concurrently with insert() and erase(). The
+ * indices released by erase() are reused. With TBB, each thread keeps the indices it releases in a local cache, so
+ * that insert() and erase() only take the lock of the table to exchange batches of free indices between threads.*/
+template<class Siblings>
+class Simplex_tree_siblings_pool {
+ public:
+  Simplex_tree_siblings_pool() : size_(0), num_shared_free_(0) {
+    for (auto& segment : segments_)
+      segment.store(nullptr, std::memory_order_relaxed);
+  }
+
+  Simplex_tree_siblings_pool(const Simplex_tree_siblings_pool&) = delete;
+  Simplex_tree_siblings_pool& operator=(const Simplex_tree_siblings_pool&) = delete;
+
+  ~Simplex_tree_siblings_pool() {
+    for (auto& segment : segments_)
+      delete[] segment.load(std::memory_order_relaxed);
+  }
+
+  /* Returns a new index for sib. Safe to call from parallel tasks.*/
+  std::uint32_t insert(Siblings* sib) {
+    std::vector<std::uint32_t>& local_indices = local_free_indices();
+    if (local_indices.empty() && num_shared_free_.load(std::memory_order_relaxed) != 0) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::size_t count = (std::min)(std::size_t(batch_size), shared_free_indices_.size());
+      local_indices.assign(shared_free_indices_.end() - count, shared_free_indices_.end());
+      shared_free_indices_.resize(shared_free_indices_.size() - count);
+      num_shared_free_.store(shared_free_indices_.size(), std::memory_order_relaxed);
+    }
+    std::uint32_t index;
+    if (!local_indices.empty()) {
+      index = local_indices.back();
+      local_indices.pop_back();
+    } else {
+      std::uint64_t new_index = size_.fetch_add(1, std::memory_order_relaxed);
+      if (new_index >= max_size)
+        throw std::length_error("Simplex_tree_siblings_pool - too many sets of siblings");
+      index = static_cast<std::uint32_t>(new_index);
+      allocate_segment(segment_of(index));
+    }
+    slot(index) = sib;
+    return index;
+  }
+
+  /* Releases index, which is not used by any set of siblings anymore. Safe to call from parallel tasks.*/
+  void erase(std::uint32_t index) {
+    std::vector<std::uint32_t>& local_indices = local_free_indices();
+    local_indices.push_back(index);
+    if (local_indices.size() >= 2 * batch_size)
+      give_back(local_indices, batch_size);
+  }
+
+  /* The set of siblings of index has moved to sib.*/
+  void update(std::uint32_t index, Siblings* sib) {
+    slot(index) = sib;
+  }
+
+  /* The segment of index was published before index was given to a node, and the node was published to the caller,
+   * so a relaxed load is enough.*/
+  Siblings* at(std::uint32_t index) const {
+    std::uint64_t position = std::uint64_t(index) + segment_size(0);
+    int segment = highest_bit(position) - first_segment_log;
+    return segments_[segment].load(std::memory_order_relaxed)[position - segment_size(segment)];
+  }
+
+ private:
+#ifdef GUDHI_USE_TBB
+  std::vector<std::uint32_t>& local_free_indices() {
+    return local_free_indices_.local();
+  }
+#else
+  std::vector<std::uint32_t>& local_free_indices() {
+    return local_free_indices_;
+  }
+#endif
+
+  /* Moves the count last indices of local_indices to the shared free indices.*/
+  void give_back(std::vector<std::uint32_t>& local_indices, std::size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shared_free_indices_.insert(shared_free_indices_.end(), local_indices.end() - count, local_indices.end());
+    local_indices.resize(local_indices.size() - count);
+    num_shared_free_.store(shared_free_indices_.size(), std::memory_order_relaxed);
+  }
+
+  void allocate_segment(int segment) {
+    if (segments_[segment].load(std::memory_order_acquire) != nullptr)
+      return;
+    Siblings** new_segment = new Siblings*[segment_size(segment)];
+    Siblings** expected = nullptr;
+    // Another thread may have allocated it in the meantime
+    if (!segments_[segment].compare_exchange_strong(expected, new_segment, std::memory_order_acq_rel))
+      delete[] new_segment;
+  }
+
+  // The segment k has 2^(first_segment_log + k) slots.
+  static const int first_segment_log = 10;
+  static const int num_segments = 32 - first_segment_log + 1;
+  static const std::uint64_t max_size = (std::uint64_t(1) << 32) - 1;
+  // Number of free indices moved at once between a thread and the table.
+  static const std::size_t batch_size = 256;
+
+  static std::uint64_t segment_size(int segment) {
+    return std::uint64_t(1) << (first_segment_log + segment);
+  }
+
+  static int highest_bit(std::uint64_t value) {
+#ifdef __GNUC__
+    return 63 - __builtin_clzll(value);
+#else
+    int bit = 0;
+    while (value >>= 1) ++bit;
+    return bit;
+#endif
+  }
+
+  static int segment_of(std::uint32_t index) {
+    return highest_bit(std::uint64_t(index) + segment_size(0)) - first_segment_log;
+  }
+
+  Siblings*& slot(std::uint32_t index) {
+    std::uint64_t position = std::uint64_t(index) + segment_size(0);
+    int segment = highest_bit(position) - first_segment_log;
+    return segments_[segment].load(std::memory_order_acquire)[position - segment_size(segment)];
+  }
+
+  std::atomic<Siblings**> segments_[num_segments];
+  std::atomic<std::uint64_t> size_;
+#ifdef GUDHI_USE_TBB
+  tbb::enumerable_thread_specific<std::vector<std::uint32_t>> local_free_indices_;
+#else
+  std::vector<std::uint32_t> local_free_indices_;
+#endif
+  std::vector<std::uint32_t> shared_free_indices_;
+  std::atomic<std::size_t> num_shared_free_;
+  std::mutex mutex_;
+};
+
+/* \brief Stands for the table of the sets of siblings in the trees without packed nodes, which do not have one.*/
+struct Simplex_tree_no_siblings_pool { };
+
+/* \brief Base of the sets of siblings, which registers them in the Simplex_tree_siblings_pool of their tree when the
+ * nodes are packed, and is empty otherwise.*/
+template<class Siblings, bool packed_nodes>
+class Simplex_tree_pooled_siblings {
+ public:
+  typedef Simplex_tree_no_siblings_pool Pool;
+
+  Pool* pool() const {
+    return nullptr;
+  }
+
+ protected:
+  Simplex_tree_pooled_siblings() { }
+  explicit Simplex_tree_pooled_siblings(Pool*) { }
+  void take_index_of(Siblings*) { }
+};
+
+template<class Siblings>
+class Simplex_tree_pooled_siblings<Siblings, true> {
+ public:
+  typedef Simplex_tree_siblings_pool<Siblings> Pool;
+
+  /* Pool of the tree of this set of siblings.*/
+  Pool* pool() const {
+    return pool_;
+  }
+
+  /* Index of this set of siblings in the pool.*/
+  std::uint32_t pool_index() const {
+    return pool_index_;
+  }
+
+ protected:
+  explicit Simplex_tree_pooled_siblings(Pool* pool)
+      : pool_(pool),
+        pool_index_(pool->insert(static_cast<Siblings*>(this))) { }
+
+  // A copy is a different set of siblings of the same tree. The nodes referring to the index of the original keep
+  // referring to it.
+  Simplex_tree_pooled_siblings(const Simplex_tree_pooled_siblings& other)
+      : pool_(other.pool_),
+        pool_index_(pool_->insert(static_cast<Siblings*>(this))) { }
+
+  Simplex_tree_pooled_siblings& operator=(const Simplex_tree_pooled_siblings&) {
+    return *this;
+  }
+
+  ~Simplex_tree_pooled_siblings() {
+    pool_->erase(pool_index_);
+  }
+
+  /* Called by the move operations of Siblings: the nodes referring to the index of other, whose members have been
+   * moved here, now refer to this, and other gets the previous pool and index of this. The pools differ when the
+   * root of a moved-from tree is reset.*/
+  void take_index_of(Siblings* other) {
+    std::swap(pool_, other->pool_);
+    std::swap(pool_index_, other->pool_index_);
+    pool_->update(pool_index_, static_cast<Siblings*>(this));
+    other->pool_->update(other->pool_index_, other);
+  }
+
+ private:
+  Pool* pool_;
+  std::uint32_t pool_index_;
+};
+
+/* \brief Whether SimplexTreeOptions::packed_nodes is defined and true.
+ *
+ * This option is optional, so that the models of SimplexTreeOptions written before it keep working.*/
+template<class SimplexTreeOptions, class = void>
+struct Simplex_tree_uses_packed_nodes : std::false_type { };
+
+template<class SimplexTreeOptions>
+struct Simplex_tree_uses_packed_nodes<SimplexTreeOptions,
+                                      typename std::enable_if<SimplexTreeOptions::packed_nodes>::type>
+    : std::true_type { };
+
+/* @} */  // end addtogroup simplex_tree
+}  // namespace Gudhi
+
+#endif  // SIMPLEX_TREE_SIMPLEX_TREE_SIBLINGS_POOL_H_
@@ -0,0 +1,102 @@
+/*    This file is part of the Gudhi Library. The Gudhi library
+ *    (Geometric Understanding in Higher Dimensions) is a generic C++
+ *    library for computational topology.
+ *
+ *    Author(s):       Gudhi contributors
+ *
+ *    Copyright (C) 2018 Inria
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIMPLEX_TREE_SERIALIZATION_UTILS_H_
+#define SIMPLEX_TREE_SERIALIZATION_UTILS_H_
+
+#include <cstring>  // for std::memcpy
+#include <cstddef>  // for std::size_t
+#include <ostream>
+#include <vector>
+
+namespace Gudhi {
+
+/* \addtogroup simplex_tree
+ * @{
+ */
+
+/* \brief Copies the bytes of value at the position start of a buffer, in the byte order of the machine.
+ * @return The position in the buffer after the value.*/
+template<class ArgumentType>
+char* serialize_trivial(ArgumentType value, char* start) {
+  std::memcpy(start, &value, sizeof(ArgumentType));
+  return start + sizeof(ArgumentType);
+}
+
+/* \brief Reads value from the bytes at the position start of a buffer, written by serialize_trivial.
+ * @return The position in the buffer after the value.*/
+template<class ArgumentType>
+const char* deserialize_trivial(ArgumentType& value, const char* start) {
+  std::memcpy(&value, start, sizeof(ArgumentType));
+  return start + sizeof(ArgumentType);
+}
+
+/* \brief Output of a serialization to a buffer that is large enough for it.*/
+class Serialization_buffer_output {
+ public:
+  explicit Serialization_buffer_output(char* buffer) : ptr_(buffer) { }
+
+  /* Returns the position where the next bytes bytes must be written.*/
+  char* reserve(std::size_t bytes) {
+    char* ptr = ptr_;
+    ptr_ += bytes;
+    return ptr;
+  }
+
+  void flush() { }
+
+ private:
+  char* ptr_;
+};
+
+/* \brief Output of a serialization to a stream, through a buffer so that os is written by large chunks.*/
+class Serialization_stream_output {
+ public:
+  explicit Serialization_stream_output(std::ostream& os) : os_(os), buffer_(std::size_t(1) << 20), size_(0) { }
+
+  /* Returns the position where the next bytes bytes must be written. It remains valid until the next call.*/
+  char* reserve(std::size_t bytes) {
+    if (size_ + bytes > buffer_.size()) {
+      flush();
+      if (bytes > buffer_.size()) buffer_.resize(bytes);
+    }
+    char* ptr = buffer_.data() + size_;
+    size_ += bytes;
+    return ptr;
+  }
+
+  /* Writes the buffered bytes in the stream.*/
+  void flush() {
+    os_.write(buffer_.data(), size_);
+    size_ = 0;
+  }
+
+ private:
+  std::ostream& os_;
+  std::vector<char> buffer_;
+  std::size_t size_;
+};
+
+/* @} */  // end addtogroup simplex_tree
+}  // namespace Gudhi
+
+#endif  // SIMPLEX_TREE_SERIALIZATION_UTILS_H_
@@ -0,0 +1,77 @@
+/*    This file is part of the Gudhi Library. The Gudhi library
+ *    (Geometric Understanding in Higher Dimensions) is a generic C++
+ *    library for computational topology.
+ *
+ *    Author(s):       Gudhi contributors
+ *
+ *    Copyright (C) 2018 Inria
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIMPLEX_TREE_BINARY_FILE_H_
+#define SIMPLEX_TREE_BINARY_FILE_H_
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <fstream>
+#include <string>
+#include <stdexcept>
+
+namespace Gudhi {
+
+/** \addtogroup simplex_tree
+ * @{
+ */
+
+/** \brief Writes a simplex tree in a binary file, with `Simplex_tree::serialize()`.
+ *
+ * @param[in] filename Name of the file, which is overwritten if it exists.
+ * @param[in] st The simplex tree.
+ * @exception std::invalid_argument If the file cannot be written.
+ */
+template<class SimplexTree>
+void write_simplex_tree_binary_file(const std::string& filename, SimplexTree& st) {
+  std::ofstream os(filename, std::ios::binary | std::ios::trunc);
+  if (!os)
+    throw std::invalid_argument("write_simplex_tree_binary_file - unable to open " + filename);
+  st.serialize(os);
+  os.close();
+  if (!os)
+    throw std::invalid_argument("write_simplex_tree_binary_file - unable to write " + filename);
+}
+
+/** \brief Reads a simplex tree from a binary file written by `write_simplex_tree_binary_file()`.
+ *
+ * The file is mapped read-only in memory, and `Simplex_tree::deserialize()` builds the simplex tree directly from the
+ * mapping, without copying or parsing the file first.
+ *
+ * @param[in] filename Name of the file.
+ * @param[in] st An empty simplex tree, of the same type as the one that was written.
+ * @exception boost::interprocess::interprocess_exception If the file cannot be mapped.
+ * @exception std::invalid_argument If the file does not contain a simplex tree of this type.
+ */
+template<class SimplexTree>
+void read_simplex_tree_binary_file(const std::string& filename, SimplexTree& st) {
+  boost::interprocess::file_mapping file(filename.c_str(), boost::interprocess::read_only);
+  boost::interprocess::mapped_region region(file, boost::interprocess::read_only);
+  region.advise(boost::interprocess::mapped_region::advice_sequential);
+  st.deserialize(static_cast<const char*>(region.get_address()), region.get_size());
+}
+
+/** @} */  // end addtogroup simplex_tree
+}  // namespace Gudhi
+
+#endif  // SIMPLEX_TREE_BINARY_FILE_H_
@@ -6,6 +6,7 @@
 #include <cmath> // float comparison
 #include <limits>
 #include <functional> // greater
+#include <random>
 
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE "simplex_tree"
@@ -18,7 +19,12 @@
 
 using namespace Gudhi;
 
-typedef boost::mpl::list<Simplex_tree<>, Simplex_tree<Simplex_tree_options_fast_persistence>> list_of_tested_variants;
+struct Arena_options : Simplex_tree_options_full_featured {
+  static const bool arena_allocation = true;
+};
+
+typedef boost::mpl::list<Simplex_tree<>, Simplex_tree<Simplex_tree_options_fast_persistence>,
+                         Simplex_tree<Arena_options>, Simplex_tree<Simplex_tree_options_packed>> list_of_tested_variants;
 
 
 bool AreAlmostTheSame(float a, float b) {
@@ -233,3 +239,35 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_expansion_2, typeST, list_of_tested_v
   BOOST_CHECK(AreAlmostTheSame(simplex_tree.filtration(simplex_tree.find({1,2,3})), 5.));
   BOOST_CHECK(simplex_tree.find({0,1,2,3}) == simplex_tree.null_simplex());
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_expansion_large_siblings, typeST, list_of_tested_variants) {
+  // Vertex 0 is linked to all the others, so that its children are a large set of siblings, which expansion is split
+  // in several tasks when TBB is available. Other edges are random.
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> filtration(1., 2.);
+  std::bernoulli_distribution is_edge(0.02);
+  const int NUMBER_OF_VERTICES = 600;
+  typeST simplex_tree;
+  for (int u = 0; u < NUMBER_OF_VERTICES; ++u) {
+    simplex_tree.insert_simplex({u}, 0.);
+    for (int v = u + 1; v < NUMBER_OF_VERTICES; ++v) {
+      if (u == 0 || is_edge(gen))
+        simplex_tree.insert_simplex({u, v}, filtration(gen));
+    }
+  }
+  typeST simplex_tree_with_blockers(simplex_tree);
+
+  simplex_tree.expansion(3);
+  // Same expansion, computed with the sequential algorithm of expansion_with_blockers
+  simplex_tree_with_blockers.expansion_with_blockers(3, [](typename typeST::Simplex_handle) { return false; });
+
+  std::cout << "********************************************************************\n";
+  std::cout << "simplex_tree_expansion_large_siblings\n";
+  std::cout << "********************************************************************\n";
+  std::cout << "* The complex contains " << simplex_tree.num_simplices() << " simplices";
+  std::cout << " - dimension " << simplex_tree.dimension() << "\n";
+
+  BOOST_CHECK(simplex_tree.dimension() == 3);
+  BOOST_CHECK(simplex_tree.num_simplices() == simplex_tree_with_blockers.num_simplices());
+  BOOST_CHECK(simplex_tree == simplex_tree_with_blockers);
+}
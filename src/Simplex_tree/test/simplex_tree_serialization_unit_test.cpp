@@ -0,0 +1,142 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <stdexcept>
+#include <algorithm>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "simplex_tree_serialization"
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+//  ^
+// /!\ Nothing else from Simplex_tree shall be included to test includes are well defined.
+#include "gudhi/Simplex_tree_binary_file.h"
+#include "gudhi/Simplex_tree.h"
+
+using namespace Gudhi;
+
+struct MyOptions : Simplex_tree_options_full_featured {
+  // Not doing persistence, so we don't need those
+  static const bool store_key = false;
+  static const bool store_filtration = false;
+  // I have few vertices
+  typedef short Vertex_handle;
+};
+
+struct Arena_options : Simplex_tree_options_full_featured {
+  static const bool arena_allocation = true;
+};
+
+typedef boost::mpl::list<Simplex_tree<>, Simplex_tree<Simplex_tree_options_fast_persistence>, Simplex_tree<MyOptions>,
+                         Simplex_tree<Arena_options>, Simplex_tree<Simplex_tree_options_packed>> list_of_tested_variants;
+
+template<class Stree_type>
+void build_random_complex(Stree_type& st, int num_vertices, int num_simplices) {
+  std::mt19937 gen(17);
+  std::uniform_int_distribution<int> vertex(0, num_vertices - 1);
+  std::uniform_int_distribution<int> dimension(0, 4);
+  std::uniform_int_distribution<int> filtration(0, 10);
+  for (int i = 0; i < num_simplices; ++i) {
+    std::vector<typename Stree_type::Vertex_handle> simplex;
+    for (int d = dimension(gen); d >= 0; --d)
+      simplex.push_back(vertex(gen));
+    std::sort(simplex.begin(), simplex.end());
+    simplex.erase(std::unique(simplex.begin(), simplex.end()), simplex.end());
+    st.insert_simplex_and_subfaces(simplex, Stree_type::Options::store_filtration ? filtration(gen) : 0);
+  }
+}
+
+// Keys in the reverse order of the filtration, so that they differ from the default ones
+template<class Stree_type>
+void assign_keys(Stree_type& st, std::true_type) {
+  typename Stree_type::Simplex_key key = st.num_simplices();
+  for (auto sh : st.filtration_simplex_range())
+    st.assign_key(sh, --key);
+}
+
+template<class Stree_type>
+void assign_keys(Stree_type&, std::false_type) { }
+
+template<class Stree_type>
+void check_same_keys(Stree_type& st1, Stree_type& st2) {
+  for (auto sh : st1.complex_simplex_range())
+    BOOST_CHECK(st1.key(sh) == st2.key(st2.find(st1.simplex_vertex_range(sh))));
+}
+
+template<class Stree_type>
+void check_keys(Stree_type& st1, Stree_type& st2, std::true_type) {
+  check_same_keys(st1, st2);
+}
+
+template<class Stree_type>
+void check_keys(Stree_type&, Stree_type&, std::false_type) { }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(serialization_in_buffer, Stree_type, list_of_tested_variants) {
+  Stree_type st;
+  build_random_complex(st, 30, 200);
+  st.initialize_filtration();
+  assign_keys(st, std::integral_constant<bool, Stree_type::Options::store_key>());
+  std::cout << "Serialization of a complex with " << st.num_simplices() << " simplices in "
+            << st.get_serialization_size() << " bytes" << std::endl;
+
+  std::vector<char> buffer(st.get_serialization_size());
+  st.serialize(buffer.data(), buffer.size());
+  BOOST_CHECK_THROW(st.serialize(buffer.data(), buffer.size() - 1), std::invalid_argument);
+
+  Stree_type read_st;
+  read_st.deserialize(buffer.data(), buffer.size());
+  BOOST_CHECK(st == read_st);
+  BOOST_CHECK(st.num_simplices() == read_st.num_simplices());
+  check_keys(st, read_st, std::integral_constant<bool, Stree_type::Options::store_key>());
+
+  // An empty complex
+  Stree_type empty_st;
+  std::vector<char> empty_buffer(empty_st.get_serialization_size());
+  empty_st.serialize(empty_buffer.data(), empty_buffer.size());
+  Stree_type read_empty_st;
+  read_empty_st.deserialize(empty_buffer.data(), empty_buffer.size());
+  BOOST_CHECK(read_empty_st == empty_st);
+  BOOST_CHECK(read_empty_st.num_simplices() == 0);
+
+  // Truncated or extended buffers are rejected
+  Stree_type truncated_st;
+  BOOST_CHECK_THROW(truncated_st.deserialize(buffer.data(), buffer.size() - 1), std::invalid_argument);
+  Stree_type header_st;
+  BOOST_CHECK_THROW(header_st.deserialize(buffer.data(), 10), std::invalid_argument);
+  buffer.push_back(0);
+  Stree_type extended_st;
+  BOOST_CHECK_THROW(extended_st.deserialize(buffer.data(), buffer.size()), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(serialization_in_file, Stree_type, list_of_tested_variants) {
+  Stree_type st;
+  build_random_complex(st, 200, 5000);
+  std::string binary_file("simplex_tree_for_serialization_unit_test.bin");
+  write_simplex_tree_binary_file(binary_file, st);
+
+  Stree_type read_st;
+  read_simplex_tree_binary_file(binary_file, read_st);
+  BOOST_CHECK(st == read_st);
+  BOOST_CHECK(st.num_simplices() == read_st.num_simplices());
+  BOOST_CHECK(st.num_simplices() > 5000);
+}
+
+BOOST_AUTO_TEST_CASE(serialization_type_mismatch) {
+  Simplex_tree<> st;
+  build_random_complex(st, 10, 20);
+  std::vector<char> buffer(st.get_serialization_size());
+  st.serialize(buffer.data(), buffer.size());
+
+  // float filtration values instead of double
+  Simplex_tree<Simplex_tree_options_fast_persistence> fast_st;
+  BOOST_CHECK_THROW(fast_st.deserialize(buffer.data(), buffer.size()), std::invalid_argument);
+  // No filtration values nor keys, short vertices
+  Simplex_tree<MyOptions> mini_st;
+  BOOST_CHECK_THROW(mini_st.deserialize(buffer.data(), buffer.size()), std::invalid_argument);
+  // Same types, allocated differently
+  Simplex_tree<Arena_options> arena_st;
+  arena_st.deserialize(buffer.data(), buffer.size());
+  BOOST_CHECK(arena_st.num_simplices() == st.num_simplices());
+}
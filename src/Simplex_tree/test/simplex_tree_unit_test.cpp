@@ -6,6 +6,7 @@
 #include <cmath> // float comparison
 #include <limits>
 #include <functional> // greater
+#include <random>
 
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE "simplex_tree"
@@ -18,7 +19,12 @@
 
 using namespace Gudhi;
 
-typedef boost::mpl::list<Simplex_tree<>, Simplex_tree<Simplex_tree_options_fast_persistence>> list_of_tested_variants;
+struct Arena_options : Simplex_tree_options_full_featured {
+  static const bool arena_allocation = true;
+};
+
+typedef boost::mpl::list<Simplex_tree<>, Simplex_tree<Simplex_tree_options_fast_persistence>,
+                         Simplex_tree<Arena_options>, Simplex_tree<Simplex_tree_options_packed>> list_of_tested_variants;
 
 
 template<class typeST>
@@ -734,6 +740,16 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(copy_move_on_simplex_tree, typeST, list_of_tested_
   // Check there is a new simplex tree reference
   BOOST_CHECK(&st_move != &st_copy);
   BOOST_CHECK(&st_move != &st);
+  // Check the parents of the nodes have been moved too
+  std::vector<typeVectorVertex> simplices_move;
+  for (auto sh : st_move.complex_simplex_range())
+    simplices_move.emplace_back(st_move.simplex_vertex_range(sh).begin(), st_move.simplex_vertex_range(sh).end());
+  std::vector<typeVectorVertex> simplices_copy;
+  for (auto sh : st_copy.complex_simplex_range())
+    simplices_copy.emplace_back(st_copy.simplex_vertex_range(sh).begin(), st_copy.simplex_vertex_range(sh).end());
+  BOOST_CHECK(simplices_move == simplices_copy);
+  for (auto sh : st_move.skeleton_simplex_range(0))
+    BOOST_CHECK(st_move.self_siblings(sh) == st_move.root());
   
   typeST st_empty;
   // Check st has been emptied by the move
@@ -895,3 +911,383 @@ BOOST_AUTO_TEST_CASE(insert_graph) {
   st2.insert_graph(g);
   BOOST_CHECK(st2.num_simplices() == 6);
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(insert_csr_graph, typeST, list_of_tested_variants) {
+  std::cout << "********************************************************************" << std::endl;
+  std::cout << "INSERT CSR GRAPH" << std::endl;
+  typedef typename boost::adjacency_list<boost::vecS, boost::vecS,
+          boost::undirectedS,
+          boost::property<vertex_filtration_t, double>,
+          boost::property<edge_filtration_t, double>> Graph;
+  // vertices don't always occur in sorted order, vertex 4 is isolated
+  std::vector<std::pair<int, int>> edges = {{0, 1}, {2, 1}, {3, 0}, {2, 0}, {1, 3}};
+  std::vector<double> edges_fil = {1., 2., 3., 4., 5.};
+  Graph g(edges.begin(), edges.end(), edges_fil.begin(), 5);
+  for (int v = 0; v < 5; v++)
+    put(Gudhi::vertex_filtration_t(), g, v, 0.5);
+
+  typeST st1;
+  st1.insert_graph(g);
+  st1.expansion(3);
+
+  // Duplicated edges keep their minimal filtration value
+  edges.emplace_back(1, 0);
+  edges_fil.push_back(6.);
+  edges.emplace_back(0, 2);
+  edges_fil.push_back(0.);
+  One_skeleton_csr_graph<double> csr_graph(5, edges, edges_fil, 0.5);
+  BOOST_CHECK(csr_graph.num_vertices() == 5);
+  BOOST_CHECK(csr_graph.num_edges() == 5);
+  BOOST_CHECK(csr_graph.upper_neighbors(0).size() == 3);
+  BOOST_CHECK(csr_graph.upper_neighbors(4).empty());
+
+  typeST st2;
+  st2.insert_graph(csr_graph);
+  BOOST_CHECK(st2.dimension() == 1);
+  BOOST_CHECK(st2.num_simplices() == 10);
+  BOOST_CHECK(st2.filtration(st2.find({0, 2})) == 0.);
+  st2.expansion(3);
+  BOOST_CHECK(st2.num_simplices() == 12);
+
+  // Restore the filtration value of the edge [0,2] to compare with the boost graph
+  edges_fil.back() = 4.;
+  typeST st3;
+  st3.insert_graph(One_skeleton_csr_graph<double>(5, edges, edges_fil, 0.5));
+  st3.expansion(3);
+  BOOST_CHECK(st1 == st3);
+
+  std::vector<std::pair<int, int>> self_loop = {{1, 1}};
+  BOOST_CHECK_THROW(One_skeleton_csr_graph<double>(2, self_loop, std::vector<double>(1, 0.)), std::invalid_argument);
+}
+
+template<class typeST>
+std::vector<std::pair<std::vector<int>, double>> simplices_and_filtrations(typeST& st) {
+  std::vector<std::pair<std::vector<int>, double>> simplices;
+  for (auto sh : st.complex_simplex_range()) {
+    std::vector<int> simplex;
+    for (auto v : st.simplex_vertex_range(sh))
+      simplex.push_back(v);
+    simplices.emplace_back(simplex, st.filtration(sh));
+  }
+  return simplices;
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_arena_allocation) {
+  typedef Simplex_tree<Arena_options> Arena_tree;
+  BOOST_CHECK(Simplex_tree_uses_arena<Arena_options>::value);
+  BOOST_CHECK(!Simplex_tree_uses_arena<Simplex_tree_options_full_featured>::value);
+
+  // Random graph dense enough to give siblings of all sizes, and to be expanded in parallel
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<double> filtration(0., 1.);
+  std::vector<std::pair<int, int>> edges;
+  std::vector<double> edges_fil;
+  for (int u = 0; u < 60; ++u)
+    for (int v = u + 1; v < 60; ++v)
+      if (filtration(gen) < 0.4) {
+        edges.emplace_back(u, v);
+        edges_fil.push_back(filtration(gen));
+      }
+  One_skeleton_csr_graph<double> csr_graph(60, edges, edges_fil, 0.);
+
+  Simplex_tree<> st;
+  st.insert_graph(csr_graph);
+  st.expansion(4);
+  Arena_tree arena_st;
+  arena_st.insert_graph(csr_graph);
+  arena_st.expansion(4);
+  std::cout << "Arena simplex tree with " << arena_st.num_simplices() << " simplices" << std::endl;
+  BOOST_CHECK(simplices_and_filtrations(st) == simplices_and_filtrations(arena_st));
+
+  // Copies and moves have their own arena
+  Arena_tree arena_copy(arena_st);
+  Arena_tree arena_moved(std::move(arena_st));
+  BOOST_CHECK(arena_st.num_simplices() == 0);
+  arena_st.insert_simplex_and_subfaces({1, 2, 3}, 0.5);
+  BOOST_CHECK(arena_st.num_simplices() == 7);
+  BOOST_CHECK(arena_copy == arena_moved);
+
+  // Deallocated siblings are reused
+  st.prune_above_filtration(0.5);
+  arena_copy.prune_above_filtration(0.5);
+  BOOST_CHECK(simplices_and_filtrations(st) == simplices_and_filtrations(arena_copy));
+  for (int i = 0; i < 100; ++i) {
+    std::vector<int> simplex = {i % 60, (7 * i + 1) % 60, (13 * i + 2) % 60, 60 + i};
+    st.insert_simplex_and_subfaces(simplex, 0.75);
+    arena_copy.insert_simplex_and_subfaces(simplex, 0.75);
+  }
+  st.remove_maximal_simplex(st.find({0, 1, 2, 60}));
+  arena_copy.remove_maximal_simplex(arena_copy.find({0, 1, 2, 60}));
+  BOOST_CHECK(simplices_and_filtrations(st) == simplices_and_filtrations(arena_copy));
+
+  st.expansion_with_blockers(3, [](Simplex_tree<>::Simplex_handle) { return false; });
+  arena_copy.expansion_with_blockers(3, [](Arena_tree::Simplex_handle) { return false; });
+  BOOST_CHECK(simplices_and_filtrations(st) == simplices_and_filtrations(arena_copy));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_freeze, typeST, list_of_tested_variants) {
+  typeST st;
+  st.insert_simplex_and_subfaces({0, 1, 6, 7}, 4.0);
+  st.insert_simplex_and_subfaces({3, 4, 5}, 3.0);
+  st.insert_simplex_and_subfaces({3, 0}, 2.0);
+  st.insert_simplex_and_subfaces({2, 1, 0}, 3.0);
+  st.insert_simplex({8}, 1.0);
+
+  auto frozen = st.freeze();
+  BOOST_CHECK(frozen.num_simplices() == st.num_simplices());
+  BOOST_CHECK(frozen.dimension() == st.dimension());
+  BOOST_CHECK(frozen.skeleton_simplex_range(0).size() == st.num_vertices());
+  BOOST_CHECK(frozen.filtration(frozen.null_simplex()) == std::numeric_limits<double>::infinity());
+
+  auto fsh = frozen.filtration_simplex_range().begin();
+  for (auto sh : st.filtration_simplex_range()) {
+    BOOST_CHECK(*fsh == st.key(sh));
+    BOOST_CHECK(frozen.key(*fsh) == st.key(sh));
+    BOOST_CHECK(frozen.simplex(st.key(sh)) == *fsh);
+    BOOST_CHECK(frozen.filtration(*fsh) == st.filtration(sh));
+    BOOST_CHECK(frozen.dimension(*fsh) == st.dimension(sh));
+    std::vector<std::pair<typename typeST::Simplex_key, int>> boundary, frozen_boundary;
+    for (auto b : st.boundary_oriented_simplex_range(sh))
+      boundary.emplace_back(st.key(b.first), b.second);
+    for (auto b : frozen.boundary_oriented_simplex_range(*fsh))
+      frozen_boundary.emplace_back(frozen.key(b.first), b.second);
+    BOOST_CHECK(boundary == frozen_boundary);
+    BOOST_CHECK(frozen.boundary_simplex_range(*fsh).size() == boundary.size());
+    if (st.dimension(sh) == 1) {
+      auto endpoints = frozen.endpoints(*fsh);
+      BOOST_CHECK(frozen.dimension(endpoints.first) == 0);
+      BOOST_CHECK(frozen.dimension(endpoints.second) == 0);
+    }
+    ++fsh;
+  }
+  BOOST_CHECK(fsh == frozen.filtration_simplex_range().end());
+
+  typeST empty_st;
+  auto empty_frozen = empty_st.freeze();
+  BOOST_CHECK(empty_frozen.num_simplices() == 0);
+  BOOST_CHECK(empty_frozen.dimension() == -1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_boundary_keys, typeST, list_of_tested_variants) {
+  typeST st;
+  st.insert_simplex_and_subfaces({0, 1, 6, 7}, 4.0);
+  st.insert_simplex_and_subfaces({3, 4, 5}, 3.0);
+  st.insert_simplex_and_subfaces({3, 0}, 2.0);
+  st.insert_simplex_and_subfaces({2, 1, 0}, 3.0);
+  st.initialize_boundary_keys();
+
+  typename typeST::Simplex_key position = 0;
+  for (auto sh : st.filtration_simplex_range()) {
+    BOOST_CHECK(st.key(sh) == position++);
+    std::vector<typename typeST::Simplex_key> boundary;
+    for (auto b : st.boundary_oriented_simplex_range(sh))
+      boundary.push_back(st.key(b.first));
+    auto boundary_keys = st.boundary_key_range(sh);
+    BOOST_CHECK(std::vector<typename typeST::Simplex_key>(boundary_keys.begin(), boundary_keys.end()) == boundary);
+    for (auto b_key : boundary_keys)
+      BOOST_CHECK(b_key < st.key(sh));
+  }
+
+  // Recomputed after a modification of the complex
+  st.insert_simplex_and_subfaces({5, 8}, 1.0);
+  st.initialize_filtration();
+  st.initialize_boundary_keys();
+  auto sh = st.find({5, 8});
+  auto boundary_keys = st.boundary_key_range(sh);
+  BOOST_CHECK(boundary_keys.size() == 2);
+  BOOST_CHECK(st.simplex(boundary_keys[0]) == st.find({5}));
+  BOOST_CHECK(st.simplex(boundary_keys[1]) == st.find({8}));
+  BOOST_CHECK(st.boundary_key_range(st.find({8})).empty());
+}
+
+/* Filtration value, then lexicographic order on the vertices read in decreasing order, computed on the vertex lists.*/
+template<class typeST>
+bool reference_is_before_in_filtration(typeST& st, typename typeST::Simplex_handle sh1,
+                                       typename typeST::Simplex_handle sh2) {
+  if (st.filtration(sh1) != st.filtration(sh2))
+    return st.filtration(sh1) < st.filtration(sh2);
+  auto rg1 = st.simplex_vertex_range(sh1);
+  auto rg2 = st.simplex_vertex_range(sh2);
+  return std::lexicographical_compare(rg1.begin(), rg1.end(), rg2.begin(), rg2.end());
+}
+
+template<class typeST>
+void test_filtration_order(typeST& st) {
+  auto const& filtration = st.filtration_simplex_range();
+  BOOST_CHECK(filtration.size() == st.num_simplices());
+  std::vector<typename typeST::Simplex_handle> reference(filtration.begin(), filtration.end());
+  std::sort(reference.begin(), reference.end(),
+            [&st](typename typeST::Simplex_handle sh1, typename typeST::Simplex_handle sh2) {
+              return reference_is_before_in_filtration(st, sh1, sh2);
+            });
+  BOOST_CHECK(std::vector<typename typeST::Simplex_handle>(filtration.begin(), filtration.end()) == reference);
+}
+
+struct Integer_filtration_options : Simplex_tree_options_full_featured {
+  typedef int Filtration_value;
+};
+
+typedef boost::mpl::list<Simplex_tree<>, Simplex_tree<Simplex_tree_options_fast_persistence>,
+                         Simplex_tree<Integer_filtration_options>> list_of_filtration_order_variants;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_filtration_order, typeST, list_of_filtration_order_variants) {
+  std::mt19937 gen(5);
+  // Few distinct filtration values, many ties
+  std::uniform_int_distribution<int> value(-3, 3);
+  for (int vertex_step : {1, 7}) {
+    if (typeST::Options::contiguous_vertices && vertex_step != 1) continue;
+    std::uniform_int_distribution<int> vertex(0, 30);
+    typeST st;
+    for (int v = 0; v <= 30; ++v)
+      st.insert_simplex({v * vertex_step}, value(gen));
+    for (int i = 0; i < 200; ++i) {
+      std::vector<int> simplex;
+      for (int j = 0; j < 4; ++j)
+        simplex.push_back(vertex(gen) * vertex_step);
+      std::sort(simplex.begin(), simplex.end());
+      simplex.erase(std::unique(simplex.begin(), simplex.end()), simplex.end());
+      st.insert_simplex_and_subfaces(simplex, value(gen));
+    }
+    st.make_filtration_non_decreasing();
+    st.initialize_filtration();
+    test_filtration_order(st);
+    for (auto sh : st.filtration_simplex_range())
+      for (auto b_sh : st.boundary_simplex_range(sh))
+        BOOST_CHECK(reference_is_before_in_filtration(st, b_sh, sh));
+  }
+
+  typeST st;
+  st.initialize_filtration();
+  BOOST_CHECK(st.filtration_simplex_range().empty());
+  st.insert_simplex_and_subfaces({2, 1, 0}, -0.);
+  st.insert_simplex_and_subfaces({3, 1}, 0.);
+  st.initialize_filtration();
+  test_filtration_order(st);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_bulk_insertion, typeST, list_of_tested_variants) {
+  typedef std::vector<typename typeST::Vertex_handle> Simplex;
+  std::mt19937 gen(3);
+  std::uniform_int_distribution<int> vertex(0, 40);
+  std::uniform_int_distribution<int> size(1, 5);
+  std::uniform_int_distribution<int> value(0, 9);
+  std::vector<Simplex> simplices;
+  std::vector<double> filtrations;
+  for (int i = 0; i < 500; ++i) {
+    Simplex simplex;
+    for (int j = size(gen); j > 0; --j)
+      simplex.push_back(vertex(gen));
+    std::sort(simplex.begin(), simplex.end());
+    simplex.erase(std::unique(simplex.begin(), simplex.end()), simplex.end());
+    // The vertices do not need to be sorted
+    std::shuffle(simplex.begin(), simplex.end(), gen);
+    simplices.push_back(simplex);
+    filtrations.push_back(value(gen));
+  }
+
+  for (bool non_empty : {false, true}) {
+    typeST st;
+    typeST bulk_st;
+    // Some of the simplices are already there, with larger or smaller filtration values
+    if (non_empty) {
+      for (int v = 0; v <= 40; ++v) {
+        st.insert_simplex({v}, 5.);
+        bulk_st.insert_simplex({v}, 5.);
+      }
+      for (std::size_t i = 0; i < simplices.size(); i += 7) {
+        st.insert_simplex_and_subfaces(simplices[i], 3.);
+        bulk_st.insert_simplex_and_subfaces(simplices[i], 3.);
+      }
+    }
+    for (std::size_t i = 0; i < simplices.size(); ++i)
+      st.insert_simplex_and_subfaces(simplices[i], filtrations[i]);
+    bulk_st.insert_simplices_and_subfaces(simplices, filtrations);
+    BOOST_CHECK(st == bulk_st);
+    BOOST_CHECK(st.dimension() == bulk_st.dimension());
+    BOOST_CHECK(st.num_simplices() == bulk_st.num_simplices());
+
+    // The parents of the new nodes are set
+    std::vector<Simplex> simplices_st;
+    for (auto sh : st.complex_simplex_range())
+      simplices_st.emplace_back(st.simplex_vertex_range(sh).begin(), st.simplex_vertex_range(sh).end());
+    std::vector<Simplex> simplices_bulk_st;
+    for (auto sh : bulk_st.complex_simplex_range())
+      simplices_bulk_st.emplace_back(bulk_st.simplex_vertex_range(sh).begin(), bulk_st.simplex_vertex_range(sh).end());
+    BOOST_CHECK(simplices_st == simplices_bulk_st);
+  }
+
+  // Same filtration value for all the simplices
+  typeST st;
+  for (auto const& simplex : simplices)
+    st.insert_simplex_and_subfaces(simplex, 2.);
+  typeST bulk_st;
+  bulk_st.insert_simplices_and_subfaces(simplices, 2.);
+  BOOST_CHECK(st == bulk_st);
+  bulk_st.insert_simplices_and_subfaces(std::vector<Simplex>());
+  BOOST_CHECK(st == bulk_st);
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_packed_nodes) {
+  typedef Simplex_tree<Simplex_tree_options_packed> Packed_tree;
+  // No padding: vertex, filtration value, key and index of the children
+  BOOST_CHECK(sizeof(Packed_tree::Dictionary::value_type) == 16);
+
+  Packed_tree st;
+  st.insert_simplex_and_subfaces({0, 1, 2, 3}, 1.5);
+  st.insert_simplex_and_subfaces({3, 4}, 0.5);
+  Packed_tree st_copy(st);
+  BOOST_CHECK(st == st_copy);
+  for (auto sh : st_copy.complex_simplex_range()) {
+    std::vector<int> simplex(st_copy.simplex_vertex_range(sh).begin(), st_copy.simplex_vertex_range(sh).end());
+    BOOST_CHECK(st.find(simplex) != st.null_simplex());
+  }
+
+  // The indices of the destroyed siblings are reused
+  for (int i = 0; i < 3; ++i) {
+    Packed_tree tmp(st);
+    tmp.insert_simplex_and_subfaces({5, 6, 7}, 2.);
+    BOOST_CHECK(tmp.num_simplices() == st.num_simplices() + 7);
+  }
+  BOOST_CHECK(st.has_children(st.find({0, 1})));
+  BOOST_CHECK(!st.has_children(st.find({4})));
+  BOOST_CHECK(st.filtration(st.find({3, 4})) == 0.5);
+}
+
+struct Arena_packed_options : Simplex_tree_options_packed {
+  static const bool arena_allocation = true;
+};
+
+BOOST_AUTO_TEST_CASE(simplex_tree_arena_and_packed_nodes) {
+  typedef Simplex_tree<Simplex_tree_options_packed> Packed_tree;
+  typedef Simplex_tree<Arena_packed_options> Arena_packed_tree;
+
+  Packed_tree st;
+  Arena_packed_tree arena_st;
+  for (int i = 0; i < 40; ++i) {
+    st.insert_simplex_and_subfaces({i, i + 1, i + 2, i + 3}, static_cast<float>(i % 7));
+    arena_st.insert_simplex_and_subfaces({i, i + 1, i + 2, i + 3}, static_cast<float>(i % 7));
+  }
+  BOOST_CHECK(simplices_and_filtrations(st) == simplices_and_filtrations(arena_st));
+
+  // Each tree has its own pool of siblings: the copies and moves of a tree do not affect the others
+  std::vector<Arena_packed_tree> trees;
+  for (int i = 0; i < 5; ++i) {
+    Arena_packed_tree copy(arena_st);
+    Arena_packed_tree moved(std::move(copy));
+    BOOST_CHECK(moved == arena_st);
+    // The moved-from tree is empty, and usable
+    BOOST_CHECK(copy.num_simplices() == 0);
+    copy.insert_simplex_and_subfaces({0, 1, 2}, 1.f);
+    BOOST_CHECK(copy.num_simplices() == 7);
+    BOOST_CHECK(copy.has_children(copy.find({0, 1})));
+    moved.insert_simplex_and_subfaces({100 + i, 101 + i, 102 + i}, 2.f);
+    trees.push_back(std::move(moved));
+  }
+  for (int i = 0; i < 5; ++i) {
+    BOOST_CHECK(trees[i].num_simplices() == arena_st.num_simplices() + 7);
+    BOOST_CHECK(trees[i].find({100 + i, 101 + i, 102 + i}) != trees[i].null_simplex());
+    BOOST_CHECK(trees[i].find({0, 1, 2, 3}) != trees[i].null_simplex());
+  }
+  trees.clear();
+  BOOST_CHECK(simplices_and_filtrations(st) == simplices_and_filtrations(arena_st));
+}
@@ -0,0 +1,336 @@
+/*    This file is part of the Gudhi Library. The Gudhi library
+ *    (Geometric Understanding in Higher Dimensions) is a generic C++
+ *    library for computational topology.
+ *
+ *    Author(s):       Gudhi contributors
+ *
+ *    Copyright (C) 2018 Inria
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ONE_SKELETON_CSR_GRAPH_H_
+#define ONE_SKELETON_CSR_GRAPH_H_
+
+#include <gudhi/Debug_utils.h>
+#include <gudhi/graph_simplicial_complex.h>  // for vertex_filtration_t, edge_filtration_t
+
+#include <boost/range/iterator_range.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/graph/graph_traits.hpp>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <vector>
+#include <utility>  // for std::pair
+#include <algorithm>  // for std::sort, std::unique
+#include <iterator>  // for std::begin, std::end
+#include <stdexcept>  // for std::invalid_argument
+#include <cstddef>  // for std::size_t
+
+namespace Gudhi {
+
+/** \brief Filtered graph stored in compressed sparse row format.
+ *
+ * \details
+ * Vertices are labeled from 0 to `num_vertices() - 1`. Each edge \f$[u,v]\f$ with \f$u < v\f$ is stored once, in the
+ * row of its lower vertex \f$u\f$: the rows are concatenated in three flat arrays (row offsets, sorted upper
+ * neighbors and edge filtration values), which uses about `sizeof(Vertex_handle) + sizeof(Filtration_value)` bytes per
+ * edge, and matches the order in which `Simplex_tree::insert_graph` creates the children of a vertex.
+ *
+ * It is also a model of
+ * <a href="http://www.boost.org/doc/libs/1_65_1/libs/graph/doc/VertexListGraph.html">boost::VertexListGraph</a> and
+ * <a href="http://www.boost.org/doc/libs/1_65_1/libs/graph/doc/EdgeListGraph.html">boost::EdgeListGraph</a>, whose
+ * vertex and edge filtration values are read with `get(vertex_filtration_t(), graph, vertex)` and
+ * `get(edge_filtration_t(), graph, edge)`. As for any graph outside of namespace boost, the free functions of these
+ * concepts are found by argument-dependent lookup, so they must be called unqualified, as in the Boost Graph
+ * algorithms: a call qualified with `boost::` does not find them.
+ *
+ * \tparam FiltrationValue Type of the vertex and edge filtration values.
+ * \tparam VertexHandle Integer type of the vertices.
+ */
+template <typename FiltrationValue, typename VertexHandle = int>
+class One_skeleton_csr_graph {
+ public:
+  typedef FiltrationValue Filtration_value;
+  typedef VertexHandle Vertex_handle;
+  /** \brief Range of the neighbors \f$v > u\f$ of a vertex \f$u\f$, sorted by increasing label. */
+  typedef boost::iterator_range<typename std::vector<Vertex_handle>::const_iterator> Upper_neighbor_range;
+  /** \brief Range of the filtration values of the edges \f$[u,v]\f$, in the order of `Upper_neighbor_range`. */
+  typedef boost::iterator_range<typename std::vector<Filtration_value>::const_iterator> Upper_edge_filtration_range;
+
+  /** \brief Edge \f$[u,v]\f$, with \f$u < v\f$, given by \f$u\f$ and the position of \f$v\f$ in the flat arrays. */
+  struct Edge {
+    Vertex_handle u;
+    std::size_t index;
+
+    bool operator==(const Edge& other) const { return u == other.u && index == other.index; }
+    bool operator!=(const Edge& other) const { return !(*this == other); }
+  };
+
+  /** \brief Iterator over all the edges, row by row. */
+  class Edge_iterator : public boost::iterator_facade<Edge_iterator, Edge, boost::forward_traversal_tag, Edge> {
+   public:
+    Edge_iterator() : graph_(nullptr), edge_{0, 0} {}
+
+    Edge_iterator(const One_skeleton_csr_graph* graph, std::size_t index) : graph_(graph), edge_{0, index} {
+      skip_finished_rows();
+    }
+
+   private:
+    friend class boost::iterator_core_access;
+
+    Edge dereference() const { return edge_; }
+
+    bool equal(const Edge_iterator& other) const { return edge_.index == other.edge_.index; }
+
+    void increment() {
+      ++edge_.index;
+      skip_finished_rows();
+    }
+
+    void skip_finished_rows() {
+      if (edge_.index >= graph_->num_edges())
+        return;
+      while (graph_->offsets_[edge_.u + 1] <= edge_.index)
+        ++edge_.u;
+    }
+
+    const One_skeleton_csr_graph* graph_;
+    Edge edge_;
+  };
+
+  /** \brief Range of all the vertices. */
+  typedef boost::iterator_range<boost::counting_iterator<Vertex_handle>> Vertex_range;
+  /** \brief Range of all the edges. */
+  typedef boost::iterator_range<Edge_iterator> Edge_range;
+
+  /** \brief Constructs an empty graph. */
+  One_skeleton_csr_graph() : offsets_(1, 0) {}
+
+  /** \brief Constructs the graph from a list of edges.
+   *
+   * The edges may come in any order, and with any orientation. When an edge is given several times, the minimal
+   * filtration value is kept. The rows are sorted in parallel if TBB is available.
+   *
+   * @param[in] num_vertices Number of vertices of the graph.
+   * @param[in] edges Range of edges, i.e. of `std::pair` of vertices smaller than `num_vertices`.
+   * @param[in] edge_filtrations Range of the filtration values of the edges, in the same order as `edges`.
+   * @param[in] vertex_filtration Filtration value of all the vertices.
+   * @exception std::invalid_argument If an edge is a self-loop.
+   */
+  template <typename EdgeRange, typename FiltrationRange>
+  One_skeleton_csr_graph(std::size_t num_vertices, const EdgeRange& edges, const FiltrationRange& edge_filtrations,
+                         Filtration_value vertex_filtration = 0)
+      : offsets_(num_vertices + 1, 0),
+        vertex_filtrations_(num_vertices, vertex_filtration) {
+    // Degree of each vertex, counting only the upper neighbors
+    for (const auto& edge : edges) {
+      Vertex_handle u = (std::min)(edge.first, edge.second);
+      if (u == (std::max)(edge.first, edge.second))
+        throw std::invalid_argument("One_skeleton_csr_graph - self-loops are not simplicial");
+      GUDHI_CHECK(u >= 0 && static_cast<std::size_t>((std::max)(edge.first, edge.second)) < num_vertices,
+                  std::invalid_argument("One_skeleton_csr_graph - vertex out of range"));
+      ++offsets_[u + 1];
+    }
+    for (std::size_t u = 0; u < num_vertices; ++u)
+      offsets_[u + 1] += offsets_[u];
+
+    // Scatter the edges in their rows
+    std::vector<std::pair<Vertex_handle, Filtration_value>> rows(offsets_[num_vertices]);
+    std::vector<std::size_t> position(offsets_.begin(), offsets_.end() - 1);
+    auto fil_it = std::begin(edge_filtrations);
+    for (auto edge_it = std::begin(edges); edge_it != std::end(edges); ++edge_it, ++fil_it) {
+      Vertex_handle u = (std::min)(edge_it->first, edge_it->second);
+      Vertex_handle v = (std::max)(edge_it->first, edge_it->second);
+      rows[position[u]++] = std::make_pair(v, static_cast<Filtration_value>(*fil_it));
+    }
+
+    // Sort each row and remove the duplicated edges, keeping the first one, i.e. the one with minimal filtration.
+    // position[u] becomes the size of the row of u.
+    auto sort_row = [&](std::size_t u) {
+      auto row_begin = rows.begin() + offsets_[u];
+      auto row_end = rows.begin() + offsets_[u + 1];
+      std::sort(row_begin, row_end);
+      position[u] = std::unique(row_begin, row_end, [](const std::pair<Vertex_handle, Filtration_value>& e1,
+                                                       const std::pair<Vertex_handle, Filtration_value>& e2) {
+        return e1.first == e2.first;
+      }) - row_begin;
+    };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), num_vertices, sort_row);
+#else
+    for (std::size_t u = 0; u < num_vertices; ++u)
+      sort_row(u);
+#endif
+
+    // Compact the rows in the final arrays
+    std::size_t num_edges = 0;
+    for (std::size_t u = 0; u < num_vertices; ++u)
+      num_edges += position[u];
+    neighbors_.reserve(num_edges);
+    edge_filtrations_.reserve(num_edges);
+    for (std::size_t u = 0; u < num_vertices; ++u) {
+      std::size_t row_begin = offsets_[u];
+      offsets_[u] = neighbors_.size();
+      for (std::size_t i = row_begin; i < row_begin + position[u]; ++i) {
+        neighbors_.push_back(rows[i].first);
+        edge_filtrations_.push_back(rows[i].second);
+      }
+    }
+    offsets_[num_vertices] = neighbors_.size();
+  }
+
+  /** \brief Returns the number of vertices. */
+  std::size_t num_vertices() const {
+    return vertex_filtrations_.size();
+  }
+
+  /** \brief Returns the number of edges. */
+  std::size_t num_edges() const {
+    return neighbors_.size();
+  }
+
+  /** \brief Returns the filtration value of the vertex u. */
+  Filtration_value vertex_filtration(Vertex_handle u) const {
+    return vertex_filtrations_[u];
+  }
+
+  /** \brief Returns the neighbors of u with a label greater than u, sorted by increasing label. */
+  Upper_neighbor_range upper_neighbors(Vertex_handle u) const {
+    return Upper_neighbor_range(neighbors_.begin() + offsets_[u], neighbors_.begin() + offsets_[u + 1]);
+  }
+
+  /** \brief Returns the range of all the vertices, from 0 to `num_vertices() - 1`. */
+  Vertex_range vertices() const {
+    return Vertex_range(boost::counting_iterator<Vertex_handle>(0),
+                        boost::counting_iterator<Vertex_handle>(static_cast<Vertex_handle>(num_vertices())));
+  }
+
+  /** \brief Returns the range of all the edges, sorted by lower vertex, then by upper vertex. */
+  Edge_range edges() const {
+    return Edge_range(Edge_iterator(this, 0), Edge_iterator(this, num_edges()));
+  }
+
+  /** \brief Returns the lower vertex of the edge e. */
+  Vertex_handle source(const Edge& e) const {
+    return e.u;
+  }
+
+  /** \brief Returns the upper vertex of the edge e. */
+  Vertex_handle target(const Edge& e) const {
+    return neighbors_[e.index];
+  }
+
+  /** \brief Returns the filtration value of the edge e. */
+  Filtration_value edge_filtration(const Edge& e) const {
+    return edge_filtrations_[e.index];
+  }
+
+  /** \brief Returns the filtration values of the edges from u to its `upper_neighbors(u)`. */
+  Upper_edge_filtration_range upper_edge_filtrations(Vertex_handle u) const {
+    return Upper_edge_filtration_range(edge_filtrations_.begin() + offsets_[u],
+                                       edge_filtrations_.begin() + offsets_[u + 1]);
+  }
+
+ private:
+  /* The upper neighbors of u are in neighbors_[offsets_[u]], ..., neighbors_[offsets_[u+1] - 1].*/
+  std::vector<std::size_t> offsets_;
+  std::vector<Vertex_handle> neighbors_;
+  std::vector<Filtration_value> edge_filtrations_;
+  std::vector<Filtration_value> vertex_filtrations_;
+};
+
+/* Free functions of the boost::VertexListGraph and boost::EdgeListGraph concepts, found by argument-dependent
+ * lookup.*/
+
+template <typename FiltrationValue, typename VertexHandle>
+std::pair<typename One_skeleton_csr_graph<FiltrationValue, VertexHandle>::Vertex_range::iterator,
+          typename One_skeleton_csr_graph<FiltrationValue, VertexHandle>::Vertex_range::iterator>
+vertices(const One_skeleton_csr_graph<FiltrationValue, VertexHandle>& graph) {
+  auto range = graph.vertices();
+  return std::make_pair(range.begin(), range.end());
+}
+
+template <typename FiltrationValue, typename VertexHandle>
+std::pair<typename One_skeleton_csr_graph<FiltrationValue, VertexHandle>::Edge_iterator,
+          typename One_skeleton_csr_graph<FiltrationValue, VertexHandle>::Edge_iterator>
+edges(const One_skeleton_csr_graph<FiltrationValue, VertexHandle>& graph) {
+  auto range = graph.edges();
+  return std::make_pair(range.begin(), range.end());
+}
+
+template <typename FiltrationValue, typename VertexHandle>
+std::size_t num_vertices(const One_skeleton_csr_graph<FiltrationValue, VertexHandle>& graph) {
+  return graph.num_vertices();
+}
+
+template <typename FiltrationValue, typename VertexHandle>
+std::size_t num_edges(const One_skeleton_csr_graph<FiltrationValue, VertexHandle>& graph) {
+  return graph.num_edges();
+}
+
+template <typename FiltrationValue, typename VertexHandle>
+VertexHandle source(const typename One_skeleton_csr_graph<FiltrationValue, VertexHandle>::Edge& e,
+                    const One_skeleton_csr_graph<FiltrationValue, VertexHandle>& graph) {
+  return graph.source(e);
+}
+
+template <typename FiltrationValue, typename VertexHandle>
+VertexHandle target(const typename One_skeleton_csr_graph<FiltrationValue, VertexHandle>::Edge& e,
+                    const One_skeleton_csr_graph<FiltrationValue, VertexHandle>& graph) {
+  return graph.target(e);
+}
+
+template <typename FiltrationValue, typename VertexHandle>
+FiltrationValue get(vertex_filtration_t, const One_skeleton_csr_graph<FiltrationValue, VertexHandle>& graph,
+                    VertexHandle u) {
+  return graph.vertex_filtration(u);
+}
+
+template <typename FiltrationValue, typename VertexHandle>
+FiltrationValue get(edge_filtration_t, const One_skeleton_csr_graph<FiltrationValue, VertexHandle>& graph,
+                    const typename One_skeleton_csr_graph<FiltrationValue, VertexHandle>::Edge& e) {
+  return graph.edge_filtration(e);
+}
+
+}  // namespace Gudhi
+
+namespace boost {
+
+template <typename FiltrationValue, typename VertexHandle>
+struct graph_traits<Gudhi::One_skeleton_csr_graph<FiltrationValue, VertexHandle>> {
+ private:
+  typedef Gudhi::One_skeleton_csr_graph<FiltrationValue, VertexHandle> Graph;
+
+ public:
+  struct traversal_category : public vertex_list_graph_tag, public edge_list_graph_tag {};
+  typedef undirected_tag directed_category;
+  typedef disallow_parallel_edge_tag edge_parallel_category;
+  typedef VertexHandle vertex_descriptor;
+  typedef typename Graph::Edge edge_descriptor;
+  typedef typename Graph::Vertex_range::iterator vertex_iterator;
+  typedef typename Graph::Edge_iterator edge_iterator;
+  typedef std::size_t vertices_size_type;
+  typedef std::size_t edges_size_type;
+
+  static vertex_descriptor null_vertex() { return -1; }
+};
+
+}  // namespace boost
+
+#endif  // ONE_SKELETON_CSR_GRAPH_H_